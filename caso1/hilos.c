@@ -1,24 +1,19 @@
+/* Compilar: gcc -O2 -I../common hilos.c ../common/hpcbench.c ../common/csvUtils.c ../common/machineInfo.c ../common/memTrack.c ../common/scaling.c -o hilos -lm -pthread
+ * Con trazas (trace.json): agregar -DHPC_TRACE ../common/trace.c */
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
-#include <sys/time.h>
 #include <string.h>
 #include <pthread.h>
 #include <unistd.h>
-#include <sys/stat.h>
-#include <errno.h>
-
-#define DATA_DIR "Hilos_Data"
 
-// Convierte timeval a segundos
-static inline double timeval_to_seconds(struct timeval tv) {
-    return (double)tv.tv_sec + (double)tv.tv_usec / 1e6;
-}
+#include "hpcbench.h"
+#include "scaling.h"
+#include "memTrack.h"
+#include "trace.h"
 
-// Estructura de estadísticas (solo real_time)
-typedef struct {
-    double real_time;
-} PerformanceStats;
+#define DATA_DIR "Hilos_Data"
 
 // Datos que recibe cada hilo
 typedef struct {
@@ -26,21 +21,9 @@ typedef struct {
     int num_threads;
     int size;
     int **A, **B, **C;
+    WorkerTimes* times;         // inicio/fin de cada hilo
 } ThreadData;
 
-// Crear directorio si no existe
-int createDirectoryIfNotExists(const char* dirPath) {
-    struct stat st = {0};
-    if (stat(dirPath, &st) == -1) {
-        if (mkdir(dirPath, 0755) == -1) {
-            fprintf(stderr, "Error creando directorio %s: %s\n",
-                    dirPath, strerror(errno));
-            return 0;
-        }
-    }
-    return 1;
-}
-
 // Crear matrices
 int** createMatrix(int size) {
     int **M = malloc(size * sizeof(int*));
@@ -73,6 +56,9 @@ void freeMatrix(int** M, int size) {
 // Multiplicación parcial por hilo
 void* multiplyThread(void* arg) {
     ThreadData* d = arg;
+    TRACE_THREAD_NAME("hilo %d", d->thread_id);
+    TRACE_BEGIN_ARG("worker", d->thread_id);
+    d->times->start[d->thread_id] = benchNow();
     for (int i = d->thread_id; i < d->size; i += d->num_threads) {
         for (int j = 0; j < d->size; j++) {
             int sum = 0;
@@ -82,17 +68,18 @@ void* multiplyThread(void* arg) {
             d->C[i][j] = sum;
         }
     }
+    d->times->end[d->thread_id] = benchNow();
+    TRACE_END("worker");
     return NULL;
 }
 
-// Multiplicación y tiempos
-void multiplyMatrices(int** A, int** B, int** C, int size, int num_threads, PerformanceStats* stats) {
+// Multiplicación medida (creación y espera de los hilos incluidas)
+void multiplyMatrices(int** A, int** B, int** C, int size, int num_threads, BenchRun* run,
+                      WorkerTimes* times) {
     pthread_t *threads = malloc(num_threads * sizeof(pthread_t));
     ThreadData *data = malloc(num_threads * sizeof(ThreadData));
 
-    struct timeval start_wall, end_wall;
-
-    gettimeofday(&start_wall, NULL);   // <-- inicio tiempo real
+    benchStart(run);
 
     for (int t = 0; t < num_threads; t++) {
         data[t].thread_id = t;
@@ -101,37 +88,18 @@ void multiplyMatrices(int** A, int** B, int** C, int size, int num_threads, Perf
         data[t].A = A;
         data[t].B = B;
         data[t].C = C;
+        data[t].times = times;
         pthread_create(&threads[t], NULL, multiplyThread, &data[t]);
     }
     for (int t = 0; t < num_threads; t++) pthread_join(threads[t], NULL);
 
-    gettimeofday(&end_wall, NULL);     // <-- fin tiempo real
-
-    stats->real_time = timeval_to_seconds(end_wall) - timeval_to_seconds(start_wall);
+    benchStop(run);
+    workerTimesJoin(times, run);
 
     free(threads);
     free(data);
 }
 
-// Escribir cabecera si no existe
-void ensureCSVHeader(const char* filename) {
-    FILE* f = fopen(filename, "r");
-    if (!f) {
-        f = fopen(filename, "w");
-        if (!f) { perror("fopen"); exit(1); }
-        fprintf(f, "matrix_size,num_threads,real_time\n");
-    }
-    if (f) fclose(f);
-}
-
-// Guardar resultados
-void appendResult(const char* filename, int size, int num_threads, PerformanceStats stats) {
-    FILE* f = fopen(filename, "a");
-    if (!f) { perror("fopen"); exit(1); }
-    fprintf(f, "%d,%d,%.9f\n", size, num_threads, stats.real_time);
-    fclose(f);
-}
-
 int main(int argc, char* argv[]) {
     if (argc < 3) {
         fprintf(stderr, "Uso: %s <tamaño_matriz> <num_hilos>\n", argv[0]);
@@ -141,30 +109,50 @@ int main(int argc, char* argv[]) {
     int num_threads = atoi(argv[2]);
 
     srand(time(NULL));
-    createDirectoryIfNotExists(DATA_DIR);
+    BenchConfig benchConfig;
+    benchConfigInit(&benchConfig);
+
+    benchEnsureDir(DATA_DIR);
 
     // Crear nombre dinámico: Hilos_Data/tiempos_Xhilos.csv
     char filename[256];
     snprintf(filename, sizeof(filename), DATA_DIR "/tiempos_%dhilos.csv", num_threads);
 
-    ensureCSVHeader(filename);
-
     printf("Creando matrices de %dx%d...\n", size, size);
+    memTrackPhase("generacion");
     int **A = createMatrix(size);
     int **B = createMatrix(size);
     int **C = createResultMatrix(size);
 
     printf("Matrices creadas. Iniciando multiplicación con %d hilos...\n", num_threads);
-    PerformanceStats stats;
-    multiplyMatrices(A, B, C, size, num_threads, &stats);
-
-    appendResult(filename, size, num_threads, stats);
+    memTrackPhase("calculo");
+    WorkerTimes times;
+    workerTimesInit(&times, num_threads, 0);
+    BenchRun run;
+    benchRunInit(&run, &benchConfig);
+    while (benchRunNext(&run))
+        multiplyMatrices(A, B, C, size, num_threads, &run, &times);
+    benchRunFinish(&run);
+
+    BenchRecord record = {"caso1", "hilos", "hilos", size, num_threads, 2.0 * size * size * (double)size};
+    benchLegacyEnd(benchLegacyRow(filename, "matrix_size,num_threads,real_time", &record, &run));
 
     printf("\n===== Resultados =====\n");
     printf("Tamaño matriz: %d, Hilos: %d\n", size, num_threads);
-    printf("Real time: %.9f s\n", stats.real_time);
+    printf("Real time: %.9f s\n", run.summary.median);
+    benchPrintSummary(&run);
     printf("Guardado en: %s\n", filename);
 
+    benchWriteUnified(".", &record, &run);
+
+    ScalingStudy scaling;
+    scalingInit(&scaling);
+    scalingAdd(&scaling, &record, &run, &times);
+    scalingFinish(&scaling, ".");
+    workerTimesFree(&times);
+    memTrackReport(".", &record);
+    benchRunFree(&run);
+
     freeMatrix(A, size);
     freeMatrix(B, size);
     freeMatrix(C, size);
@@ -1,24 +1,22 @@
+/* Compilar: gcc -O2 -I../common procesos.c ../common/hpcbench.c ../common/csvUtils.c ../common/machineInfo.c ../common/memTrack.c ../common/scaling.c ../common/procPool.c -o procesos -lm -pthread */
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
-#include <sys/time.h>
-#include <sys/resource.h>
 #include <string.h>
 #include <unistd.h>
 #include <sys/wait.h>
 #include <sys/types.h>
 #include <sys/shm.h>
 #include <sys/ipc.h>
-#include <sys/stat.h>
 #include <signal.h>
-#include <errno.h>
 
-#define DATA_DIR "Procesos_Data"
+#include "hpcbench.h"
+#include "scaling.h"
+#include "memTrack.h"
+#include "procPool.h"
 
-// Nota: ahora guardamos solo real_time (tiempo de reloj)
-typedef struct {
-    double real_time;   // tiempo real (wall-clock)
-} PerformanceStats;
+#define DATA_DIR "Procesos_Data"
 
 // Estructura para pasar datos a cada proceso
 typedef struct {
@@ -29,23 +27,12 @@ typedef struct {
     int* A_flat;
     int* B_flat;
     int* C_flat;
+    WorkerTimes* times;     // marcas de inicio/fin (memoria compartida)
 } ProcessData;
 
 #define get_element(matrix, row, col, size) ((matrix)[(row) * (size) + (col)])
 #define add_to_element(matrix, row, col, size, value) ((matrix)[(row) * (size) + (col)] += (value))
 
-// Crear directorio si no existe
-int createDirectoryIfNotExists(const char* dirPath) {
-    struct stat st = {0};
-    if (stat(dirPath, &st) == -1) {
-        if (mkdir(dirPath, 0755) == -1) {
-            fprintf(stderr, "Error: No se pudo crear %s: %s\n", dirPath, strerror(errno));
-            return 0;
-        }
-    }
-    return 1;
-}
-
 // Crear matrices compartidas
 int create_shared_matrix(int size, int** matrix_ptr) {
     size_t matrix_size = size * size * sizeof(int);
@@ -77,6 +64,7 @@ void multiplyMatricesProcessOptimized(ProcessData* data) {
     int process_id = data->process_id;
     int num_processes = data->num_processes;
     int block_size = data->block_size;
+    data->times->start[process_id] = benchNow();
 
     for (int i0 = 0; i0 < size; i0 += block_size) {
         int imax = (i0 + block_size < size) ? i0 + block_size : size;
@@ -95,29 +83,45 @@ void multiplyMatricesProcessOptimized(ProcessData* data) {
             }
         }
     }
+    data->times->end[process_id] = benchNow();
 }
 
-// Multiplicar matrices con procesos (fork)
-void multiplyMatricesWithProcesses(int* A, int* B, int* C, int size, int num_processes) {
-    pid_t* pids = (pid_t*)malloc(num_processes * sizeof(pid_t));
-    if (!pids) { fprintf(stderr, "Error malloc\n"); exit(EXIT_FAILURE); }
+// Datos comunes a todos los procesos; se arman antes de crear el pool
+void initProcessData(ProcessData* data, int* A, int* B, int* C, int size, int num_processes,
+                     WorkerTimes* times) {
+    data->process_id = 0;
+    data->size = size;
+    data->num_processes = num_processes;
+    data->A_flat = A;
+    data->B_flat = B;
+    data->C_flat = C;
+    data->block_size = (size > 2000) ? 128 : (size > 1000) ? 64 : 32;
+    data->times = times;
+}
+
+// Tarea del pool: la copia de data que heredó el hijo, con su id
+void multiplyTask(void* arg, int worker) {
+    ProcessData data = *(ProcessData*)arg;
+    data.process_id = worker;
+    multiplyMatricesProcessOptimized(&data);
+}
 
-    int block_size = (size > 2000) ? 128 : (size > 1000) ? 64 : 32;
+// Multiplicar matrices con procesos: el pool persistente o, sin él, un fork por repetición
+void multiplyMatricesWithProcesses(ProcPool* pool, ProcessData* data) {
+    if (pool != NULL) {
+        procPoolRun(pool, data->num_processes, multiplyTask, data);
+        return;
+    }
 
-    ProcessData data;
-    data.size = size;
-    data.num_processes = num_processes;
-    data.A_flat = A;
-    data.B_flat = B;
-    data.C_flat = C;
-    data.block_size = block_size;
+    int num_processes = data->num_processes;
+    pid_t* pids = (pid_t*)malloc(num_processes * sizeof(pid_t));
+    if (!pids) { fprintf(stderr, "Error malloc\n"); exit(EXIT_FAILURE); }
 
     for (int i = 0; i < num_processes; i++) {
         pids[i] = fork();
         if (pids[i] < 0) { perror("fork"); exit(EXIT_FAILURE); }
         else if (pids[i] == 0) {
-            data.process_id = i;
-            multiplyMatricesProcessOptimized(&data);
+            multiplyTask(data, i);
             _exit(EXIT_SUCCESS); // salir sin ejecutar código de limpieza del padre
         }
     }
@@ -131,28 +135,6 @@ int getNumCPUs() {
     return (n > 0) ? (int)n : 1;
 }
 
-// Convertir timespec a segundos (double)
-double timespec_to_seconds(struct timespec ts) {
-    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
-}
-
-// Escribir cabecera en CSV si está vacío (ahora real_time)
-void writeCSVHeaderIfNeeded(const char* filename) {
-    FILE* f = fopen(filename, "a+");
-    if (!f) return;
-    fseek(f, 0, SEEK_END);
-    if (ftell(f) == 0) fprintf(f, "tamañoMatriz,#procesos,real_time\n");
-    fclose(f);
-}
-
-// Guardar resultados (real_time)
-void appendResults(const char* filename, int size, int num_processes, double real_time) {
-    FILE* f = fopen(filename, "a");
-    if (!f) return;
-    fprintf(f, "%d,%d,%.9f\n", size, num_processes, real_time);
-    fclose(f);
-}
-
 int main(int argc, char* argv[]) {
     if (argc < 2 || argc > 3) {
         fprintf(stderr, "Uso: %s <tamaño_matriz> [num_procesos]\n", argv[0]);
@@ -165,15 +147,18 @@ int main(int argc, char* argv[]) {
 
     srand(time(NULL));
 
-    if (!createDirectoryIfNotExists(DATA_DIR)) return EXIT_FAILURE;
+    BenchConfig benchConfig;
+    benchConfigInit(&benchConfig);
+
+    benchEnsureDir(DATA_DIR);
 
     // Archivo dinámico según procesos: Procesos_Data/tiempos_Xprocesos.csv
     char filename[256];
     snprintf(filename, sizeof(filename), DATA_DIR "/tiempos_%dprocesos.csv", num_processes);
 
-    writeCSVHeaderIfNeeded(filename);
-
+    /* Las matrices van en memoria compartida de System V: memTrack no las ve */
     printf("Creando matrices de %dx%d...\n", size, size);
+    memTrackPhase("generacion");
     int *A, *B, *C;
     int shmid_A = create_shared_matrix(size, &A);
     int shmid_B = create_shared_matrix(size, &B);
@@ -181,29 +166,38 @@ int main(int argc, char* argv[]) {
 
     fillMatrix(A, size);
     fillMatrix(B, size);
-    initResultMatrix(C, size);
 
     printf("Matrices creadas. Iniciando multiplicación con %d procesos...\n", num_processes);
+    memTrackPhase("calculo");
 
-    // MEDICIÓN DE TIEMPO REAL: usar CLOCK_MONOTONIC
-    struct timespec start_ts, end_ts;
-    if (clock_gettime(CLOCK_MONOTONIC, &start_ts) != 0) {
-        perror("clock_gettime inicio");
-        // aun así continuamos, pero la medicion será inválida
-    }
-
-    multiplyMatricesWithProcesses(A, B, C, size, num_processes);
+    WorkerTimes times;
+    workerTimesInit(&times, num_processes, 1);
 
-    if (clock_gettime(CLOCK_MONOTONIC, &end_ts) != 0) {
-        perror("clock_gettime fin");
+    /* Los hijos se crean una vez, con las matrices ya en memoria compartida:
+     * las repeticiones no pagan fork ni wait (PROC_POOL=0 para compararlo) */
+    ProcessData data;
+    initProcessData(&data, A, B, C, size, num_processes, &times);
+    ProcPool* pool = procPoolEnabled() ? procPoolCreate(num_processes) : NULL;
+
+    BenchRun run;
+    benchRunInit(&run, &benchConfig);
+    while (benchRunNext(&run)) {
+        initResultMatrix(C, size);     // los hijos acumulan en C
+        benchStart(&run);
+        multiplyMatricesWithProcesses(pool, &data);
+        benchStop(&run);
+        workerTimesJoin(&times, &run);
     }
+    benchRunFinish(&run);
+    /* El CPU de los hijos del pool recién llega al padre cuando terminan */
+    if (pool != NULL) benchCpuTimeUnknown(&run);
+    procPoolFree(pool);
 
-    PerformanceStats stats;
-    stats.real_time = timespec_to_seconds(end_ts) - timespec_to_seconds(start_ts);
-
-    appendResults(filename, size, num_processes, stats.real_time);
+    BenchRecord record = {"caso1", "procesos", "procesos", size, num_processes, 2.0 * size * size * (double)size};
+    benchLegacyEnd(benchLegacyRow(filename, "tamañoMatriz,#procesos,real_time", &record, &run));
 
     if (size <= 500) {
+        memTrackPhase("verificacion");
         printf("Validando resultados...\n");
         int correct = 1;
         for (int i = 0; i < size && correct; i++) {
@@ -221,9 +215,20 @@ int main(int argc, char* argv[]) {
 
     printf("\n===== Resultados =====\n");
     printf("Matriz %d x %d con %d procesos\n", size, size, num_processes);
-    printf("Real time: %.9f s\n", stats.real_time);
+    printf("Real time: %.9f s\n", run.summary.median);
+    benchPrintSummary(&run);
     printf("Guardado en: %s\n", filename);
 
+    benchWriteUnified(".", &record, &run);
+
+    ScalingStudy scaling;
+    scalingInit(&scaling);
+    scalingAdd(&scaling, &record, &run, &times);
+    scalingFinish(&scaling, ".");
+    workerTimesFree(&times);
+    memTrackReport(".", &record);
+    benchRunFree(&run);
+
     // Desconectar y eliminar memoria compartida
     shmdt(A); shmdt(B); shmdt(C);
     shmctl(shmid_A, IPC_RMID, NULL);
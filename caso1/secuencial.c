@@ -1,15 +1,14 @@
+/* Compilar: gcc -O2 -I../common secuencial.c ../common/hpcbench.c ../common/csvUtils.c ../common/machineInfo.c ../common/memTrack.c -o secuencial -lm -pthread */
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
-#include <sys/time.h>
-#include <sys/resource.h>
-#include <sys/stat.h>
+#include <string.h>
 
-#define DATA_DIR "Secuencial_Data"
+#include "hpcbench.h"
+#include "memTrack.h"
 
-typedef struct {
-    double user_time;   // Solo nos interesa el tiempo de usuario
-} PerformanceStats;
+#define DATA_DIR "Secuencial_Data"
 
 int** createMatrix(int size) {
     int** matrix = (int**)malloc(size * sizeof(int*));
@@ -66,16 +65,6 @@ void multiplyMatrices(int** A, int** B, int** C, int size) {
     }
 }
 
-void createDirectoryIfNotExists(const char* dirPath) {
-    struct stat st = {0};
-    if (stat(dirPath, &st) == -1) {
-        if (mkdir(dirPath, 0700) != 0) {
-            fprintf(stderr, "Error: No se pudo crear el directorio %s\n", dirPath);
-            exit(EXIT_FAILURE);
-        }
-    }
-}
-
 char* generateFilename(const char* dirPath) {
     char* filename = (char*)malloc(256);
     if (filename == NULL) {
@@ -86,33 +75,6 @@ char* generateFilename(const char* dirPath) {
     return filename;
 }
 
-void writeCSVHeaderIfNotExists(const char* filename) {
-    struct stat st;
-    if (stat(filename, &st) != 0) {
-        FILE* file = fopen(filename, "w");
-        if (file == NULL) {
-            fprintf(stderr, "Error: No se pudo crear el archivo CSV %s\n", filename);
-            exit(EXIT_FAILURE);
-        }
-        fprintf(file, "size,user_time\n");
-        fclose(file);
-    }
-}
-
-void writeResultsToCSV(const char* filename, int size, PerformanceStats stats) {
-    FILE* file = fopen(filename, "a");
-    if (file == NULL) {
-        fprintf(stderr, "Error: No se pudo abrir el archivo CSV para escritura\n");
-        return;
-    }
-    fprintf(file, "%d,%.9f\n", size, stats.user_time);
-    fclose(file);
-}
-
-double timeval_to_seconds(struct timeval tv) {
-    return tv.tv_sec + (tv.tv_usec / 1000000.0);
-}
-
 int main(int argc, char* argv[]) {
     if (argc < 2) {
         fprintf(stderr, "Uso: %s <tamaño_matriz>\n", argv[0]);
@@ -127,30 +89,43 @@ int main(int argc, char* argv[]) {
 
     srand(time(NULL));
 
-    createDirectoryIfNotExists(DATA_DIR);
+    BenchConfig benchConfig;
+    benchConfigInit(&benchConfig);
+
+    benchEnsureDir(DATA_DIR);
     char* csvFilename = generateFilename(DATA_DIR);
-    writeCSVHeaderIfNotExists(csvFilename);
 
     printf("Creando matrices de %dx%d...\n", size, size);
+    memTrackPhase("generacion");
     int** A = createMatrix(size);
     int** B = createMatrix(size);
     int** C = createResultMatrix(size);
     printf("Matrices creadas. Iniciando multiplicación...\n");
-    PerformanceStats stats = {0};
-
-    struct rusage start_usage, end_usage;
-
-    if (getrusage(RUSAGE_SELF, &start_usage) < 0) perror("Error en getrusage inicial");
-    multiplyMatrices(A, B, C, size);
-    if (getrusage(RUSAGE_SELF, &end_usage) < 0) perror("Error en getrusage final");
-
-    stats.user_time = timeval_to_seconds(end_usage.ru_utime) - timeval_to_seconds(start_usage.ru_utime);
+    memTrackPhase("calculo");
+
+    BenchRun run;
+    benchRunInit(&run, &benchConfig);
+    while (benchRunNext(&run)) {
+        for (int i = 0; i < size; i++) memset(C[i], 0, size * sizeof(int));  // C acumula
+        benchStart(&run);
+        multiplyMatrices(A, B, C, size);
+        benchStop(&run);
+    }
+    benchRunFinish(&run);
 
-    writeResultsToCSV(csvFilename, size, stats);
+    BenchRecord record = {"caso1", "secuencial", "secuencial", size, 1, 2.0 * size * size * (double)size};
+    // El CSV histórico solo guarda el tiempo de usuario
+    benchLegacyEnd(benchLegacyRow(csvFilename, "size,user_time", &record, &run));
 
     printf("\n===== Resultados =====\n");
     printf("Tamaño de la matriz: %d x %d\n", size, size);
-    printf("Tiempo de usuario: %.9f segundos\n", stats.user_time);
+    printf("Tiempo de usuario: %.9f segundos\n", run.user_time);
+    printf("Tiempo real: %.9f segundos\n", run.summary.median);
+    benchPrintSummary(&run);
+
+    benchWriteUnified(".", &record, &run);
+    memTrackReport(".", &record);
+    benchRunFree(&run);
 
     freeMatrix(A, size);
     freeMatrix(B, size);
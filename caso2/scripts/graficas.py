@@ -1,3 +1,4 @@
+import numpy as np
 import pandas as pd
 import matplotlib.pyplot as plt
 import os
@@ -110,5 +111,91 @@ plt.savefig(out_path)
 plt.close()
 print(f"✅ Gráfica comparativa con todos los hilos creada: {out_path}")
 
+# === 4️⃣ Roofline (corridas con ROOFLINE=1) ===
+roofline_csv = os.path.join(base_path, "Roofline_Data", "Roofline_Results.csv")
+if os.path.exists(roofline_csv):
+    df_roof = pd.read_csv(roofline_csv)
+    for hilos, grupo in df_roof.groupby("threads"):
+        pico = grupo["peak_compute_gops"].iloc[-1]
+        banda = grupo["peak_bandwidth_gbs"].iloc[-1]
+        finitas = grupo["intensity"].replace(np.inf, np.nan).dropna()
+        x_min = min(0.01, finitas.min() / 2) if not finitas.empty else 0.01
+        x_max = max(100.0, finitas.max() * 2) if not finitas.empty else 100.0
+        x = np.logspace(np.log10(x_min), np.log10(x_max), 200)
+
+        plt.figure(figsize=(9, 6))
+        plt.loglog(x, np.minimum(pico, x * banda), 'k-', linewidth=2,
+                   label=f"Techo ({pico:.1f} Gop/s, {banda:.1f} GB/s)")
+        for algoritmo, puntos in grupo.groupby("benchmark"):
+            intensidad = puntos["intensity"].replace(np.inf, x_max)
+            plt.loglog(intensidad, puntos["achieved_gops"], 'o', label=algoritmo)
+
+        plt.title(f"Roofline ({hilos} hilos)")
+        plt.xlabel("Intensidad aritmética (op/B)")
+        plt.ylabel("Rendimiento (Gop/s)")
+        plt.legend(fontsize=8)
+        plt.grid(True, which="both", alpha=0.3)
+        plt.tight_layout()
+        out_path = os.path.join(graficas_path, f"Roofline_{hilos}hilos.png")
+        plt.savefig(out_path)
+        plt.close()
+        print(f"✅ Gráfica roofline creada: {out_path}")
+
+# === 5️⃣ Comparación entre máquinas por huella (Bench_Results + Machine_Info) ===
+# Cada binario etiqueta sus filas con machine_id/build_id; se juntan todos
+# los Bench_Results.csv bajo results/ (p. ej. los copiados de otra máquina)
+def cargar_unificados(raiz):
+    bench, info = [], []
+    for carpeta, _, archivos_dir in os.walk(raiz):
+        if "Bench_Results.csv" in archivos_dir:
+            bench.append(pd.read_csv(os.path.join(carpeta, "Bench_Results.csv")))
+        if "Machine_Info.csv" in archivos_dir:
+            info.append(pd.read_csv(os.path.join(carpeta, "Machine_Info.csv")))
+    if not bench or not info:
+        return None, None
+    df = pd.concat(bench, ignore_index=True)
+    if "machine_id" not in df.columns:
+        return None, None
+    df = df.dropna(subset=["machine_id"]).drop_duplicates()
+    maquinas = pd.concat(info, ignore_index=True).drop_duplicates(subset=["machine_id", "build_id"])
+    return df, maquinas
+
+df_bench, df_maquinas = cargar_unificados(base_path)
+if df_bench is not None:
+    df_bench = df_bench[df_bench["project"] == "caso2"]
+    seq = df_bench[df_bench["program"] == "secuencial"]
+    omp = df_bench[df_bench["program"] == "openmp_opt"]
+    # Mejor variante de OpenMP por máquina/compilación, tamaño e hilos
+    omp = omp.groupby(["machine_id", "build_id", "size", "workers"], as_index=False)["median_s"].min()
+    seq = seq.groupby(["machine_id", "build_id", "size"], as_index=False)["median_s"].min()
+    # Solo se compara secuencial y OpenMP medidos en la misma máquina con la misma compilación
+    speedups = omp.merge(seq, on=["machine_id", "build_id", "size"], suffixes=("_omp", "_seq"))
+    speedups["speedup"] = speedups["median_s_seq"] / speedups["median_s_omp"]
+
+    if not speedups.empty:
+        etiquetas = {(r.machine_id, r.build_id): f"{r.cpu_model} ({r.host}, {r.threads} hilos)"
+                     for r in df_maquinas.itertuples()}
+        flags = df_maquinas.set_index(["machine_id", "build_id"])["cflags"]
+        usadas = speedups[["machine_id", "build_id"]].drop_duplicates()
+        if usadas.apply(lambda r: flags.get((r.machine_id, r.build_id)), axis=1).nunique() > 1:
+            print("⚠️ Las máquinas comparadas usan flags de compilación distintos (ver Machine_Info.csv)")
+
+        plt.figure(figsize=(10, 6))
+        for (maq, build, hilos), grupo in speedups.groupby(["machine_id", "build_id", "workers"]):
+            grupo = grupo.sort_values("size")
+            nombre = etiquetas.get((maq, build), maq)
+            plt.plot(grupo["size"], grupo["speedup"], marker='o', label=f"{nombre} - {hilos} hilos")
+
+        plt.title("Speedup OpenMP vs Secuencial por máquina (huella)")
+        plt.xlabel("Tamaño de matriz")
+        plt.ylabel("Speedup (Tseq / Topenmp)")
+        plt.legend(fontsize=7)
+        plt.grid(True)
+        plt.tight_layout()
+        out_path = os.path.join(graficas_path, "Comparacion_Maquinas_Huella.png")
+        plt.savefig(out_path)
+        plt.close()
+        print(f"✅ Gráfica entre máquinas por huella creada: {out_path}")
+
 print("\n🎯 ¡Gráficas consolidadas correctamente en 'results/graficas'!")
 
@@ -1,7 +1,13 @@
 #!/usr/bin/env python3
 """
 test.py — Ejecuta pruebas para tamaños específicos de matrices
-Secuencial + OpenMP (2,4,8,12 hilos), 10 repeticiones por configuración
+Secuencial + OpenMP (2,4,8,12 hilos). Cada configuración se repite hasta
+que el IC 95% de la mediana quede en ±2% (entre 5 y 50 repeticiones).
+
+Cada binario corre una sola vez en modo --sweep: las matrices se generan
+una vez, el pool de hilos se reutiliza y las repeticiones se hacen en el
+mismo proceso. Los tiempos de cada repetición quedan en
+results/Bench_Samples.csv.
 """
 
 import subprocess
@@ -10,35 +16,44 @@ from pathlib import Path
 # Tamaños específicos
 SIZES = [675, 911, 1229, 1658, 2239, 3023, 4081]
 OMP_THREADS = [2, 4, 8, 12]
-RUNS = 10
+# Modo adaptativo: RUNS es el tope de repeticiones
+RUNS = 50
+MIN_RUNS = 5
+TARGET_CI = 0.02
+WARMUP = 1
 
 BASE_DIR = Path(__file__).resolve().parent.parent
 BIN_DIR = BASE_DIR / "bin"
 RESULTS_DIR = BASE_DIR / "results"
 SEQ_BIN = BIN_DIR / "secuencial"
 OMP_BIN = BIN_DIR / "openmp_opt"
+SAMPLES_CSV = RESULTS_DIR / "Bench_Samples.csv"
 
 def compile_if_needed():
     if not SEQ_BIN.exists() or not OMP_BIN.exists():
         print("Compilando binarios...")
         subprocess.run(["make", "all"], check=True)
 
+def sweep_args(sizes, runs):
+    return [
+        "--sweep",
+        "sizes=" + ",".join(str(s) for s in sizes),
+        f"reps={runs}",
+        f"minreps={MIN_RUNS}",
+        f"ci={TARGET_CI}",
+        f"warmup={WARMUP}",
+        f"samples={SAMPLES_CSV}",
+    ]
+
 def run_tests(sizes, runs):
     compile_if_needed()
 
-    for size in sizes:
-        print(f"\n===== Tamaño {size}x{size} =====")
-
-        # Secuencial
-        for r in range(1, runs + 1):
-            print(f"  Secuencial - ejecución {r}")
-            subprocess.run([str(SEQ_BIN), str(size)], check=True)
+    print("\n===== Secuencial =====")
+    subprocess.run([str(SEQ_BIN)] + sweep_args(sizes, runs), check=True)
 
-        # OpenMP
-        for t in OMP_THREADS:
-            for r in range(1, runs + 1):
-                print(f"  OpenMP - hilos {t}, ejecución {r}")
-                subprocess.run([str(OMP_BIN), str(size), str(t)], check=True)
+    print("\n===== OpenMP =====")
+    threads = "threads=" + ",".join(str(t) for t in OMP_THREADS)
+    subprocess.run([str(OMP_BIN)] + sweep_args(sizes, runs) + [threads], check=True)
 
     print("\nPruebas completadas. Los resultados se guardan directamente en CSV.")
 
@@ -0,0 +1,196 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "microbench.h"
+#include "fixedKernels.h"
+#include "dense.h"
+#include "matvec.h"
+
+#ifndef RESULTS_DIR
+#define RESULTS_DIR "results"
+#endif
+
+/* ==========================================
+ * Microbenchmarks de caso2
+ * ==========================================
+ * Grupos:
+ *   gemm  C = A·B: ijk e ikj_bloques son referencias locales (libro de
+ *         texto y bloqueo por caché); omp_filas es multiplyMatricesOMP
+ *         (dense.c) y simd_fijo el kernel especializado de fixedKernels.h
+ *         cuando existe para el tamaño. El kernel de secuencial.c es el
+ *         mismo ikj que omp_filas con 1 hilo.
+ *   gemv  y = A·x de matvec.c, normal y con prefetch no temporal.
+ * Los kernels acumulan en C, así que cada llamada limpia C antes (n² frente
+ * a n³ operaciones; para N=16 pesa algo, para N>=64 es despreciable).
+ */
+#define BLOCK 64
+
+static const long defaultGemmSizes[] = { 64, 128, 256, 512 };
+static const long defaultGemvSizes[] = { 1024, 4096 };
+
+typedef struct {
+    int** A;
+    int** B;
+    int** C;
+    int* x;
+    int* y;
+    int size;
+    int threads;
+    FixedKernelFn fixed;
+} MatrixCtx;
+
+static int** newMatrix(int n) {
+    int** M = (int**)malloc(n * sizeof(int*));
+    if (M == NULL) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para la matriz\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++) {
+        M[i] = (int*)malloc(n * sizeof(int));
+        if (M[i] == NULL) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para la fila %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+        for (int j = 0; j < n; j++) M[i][j] = rand() % 100 + 1;
+    }
+    return M;
+}
+
+static void freeMatrix(int** M, int n) {
+    for (int i = 0; i < n; i++) free(M[i]);
+    free(M);
+}
+
+static void clearC(MatrixCtx* m) {
+    for (int i = 0; i < m->size; i++) memset(m->C[i], 0, m->size * sizeof(int));
+}
+
+/* ==========================================
+ * Variantes de GEMM
+ * ========================================== */
+static void gemmIjk(void* ctx) {
+    MatrixCtx* m = (MatrixCtx*)ctx;
+    const int n = m->size;
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++) {
+            int sum = 0;
+            for (int k = 0; k < n; k++) sum += m->A[i][k] * m->B[k][j];
+            m->C[i][j] = sum;
+        }
+}
+
+/* ikj por bloques de BLOCK x BLOCK: el bloque de B se reutiliza desde L1/L2 */
+static void gemmBlocked(void* ctx) {
+    MatrixCtx* m = (MatrixCtx*)ctx;
+    const int n = m->size;
+    clearC(m);
+    for (int k0 = 0; k0 < n; k0 += BLOCK) {
+        const int kEnd = k0 + BLOCK < n ? k0 + BLOCK : n;
+        for (int j0 = 0; j0 < n; j0 += BLOCK) {
+            const int jEnd = j0 + BLOCK < n ? j0 + BLOCK : n;
+            for (int i = 0; i < n; i++) {
+                int* c = m->C[i];
+                for (int k = k0; k < kEnd; k++) {
+                    const int a = m->A[i][k];
+                    const int* b = m->B[k];
+                    for (int j = j0; j < jEnd; j++) c[j] += a * b[j];
+                }
+            }
+        }
+    }
+}
+
+static void gemmRows(void* ctx) {
+    MatrixCtx* m = (MatrixCtx*)ctx;
+    clearC(m);
+    multiplyMatricesOMP(m->A, m->B, m->C, m->size, m->threads, NULL);
+}
+
+static void gemmFixed(void* ctx) {
+    MatrixCtx* m = (MatrixCtx*)ctx;
+    clearC(m);
+    m->fixed(m->A, m->B, m->C, m->threads);
+}
+
+/* ==========================================
+ * Variantes de GEMV
+ * ========================================== */
+static void gemvPlain(void* ctx) {
+    MatrixCtx* m = (MatrixCtx*)ctx;
+    gemvOMP(m->A, m->x, m->y, m->size, m->threads, 0);
+}
+
+static void gemvStream(void* ctx) {
+    MatrixCtx* m = (MatrixCtx*)ctx;
+    gemvOMP(m->A, m->x, m->y, m->size, m->threads, 1);
+}
+
+/* ==========================================
+ * Grilla
+ * ========================================== */
+static void benchGemm(MicroSuite* suite, int n, int threads) {
+    MatrixCtx m = { newMatrix(n), newMatrix(n), newMatrix(n), NULL, NULL, n, threads, findFixedKernel(n) };
+    MicroCase c = { "gemm", "ijk", n, threads, 2.0 * n * n * n, 3.0 * n * n * sizeof(int) };
+
+    /* ijk es secuencial: solo como referencia con 1 hilo */
+    if (threads == 1) microRun(suite, &c, gemmIjk, &m);
+    if (threads == 1) {
+        c.variant = "ikj_bloques";
+        microRun(suite, &c, gemmBlocked, &m);
+    }
+    c.variant = "omp_filas";
+    microRun(suite, &c, gemmRows, &m);
+    if (m.fixed != NULL) {
+        c.variant = "simd_fijo";
+        microRun(suite, &c, gemmFixed, &m);
+    }
+    freeMatrix(m.A, n);
+    freeMatrix(m.B, n);
+    freeMatrix(m.C, n);
+}
+
+static void benchGemv(MicroSuite* suite, int n, int threads) {
+    MatrixCtx m = { newMatrix(n), NULL, NULL, NULL, NULL, n, threads, NULL };
+    m.x = (int*)malloc(n * sizeof(int));
+    m.y = (int*)malloc(n * sizeof(int));
+    if (m.x == NULL || m.y == NULL) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para los vectores\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++) m.x[i] = rand() % 100 + 1;
+
+    MicroCase c = { "gemv", "normal", n, threads, 2.0 * n * n, (double)gemvBytes(n) };
+    microRun(suite, &c, gemvPlain, &m);
+    c.variant = "streaming";
+    microRun(suite, &c, gemvStream, &m);
+
+    freeMatrix(m.A, n);
+    free(m.x);
+    free(m.y);
+}
+
+int main(int argc, char* argv[]) {
+    MicroSuite suite;
+    BenchSweep grid;
+    microInit(&suite, "caso2", &grid, argc, argv);
+    if (grid.nworkers == 0) {
+        grid.nworkers = 1;
+        grid.workers[0] = 1;
+    }
+    srand(42);
+
+    /* Sin sizes= cada grupo usa su grilla; con sizes= ambos usan la dada */
+    int nGemm = grid.nsizes ? grid.nsizes : (int)(sizeof(defaultGemmSizes) / sizeof(long));
+    int nGemv = grid.nsizes ? grid.nsizes : (int)(sizeof(defaultGemvSizes) / sizeof(long));
+    const long* gemmSizes = grid.nsizes ? grid.sizes : defaultGemmSizes;
+    const long* gemvSizes = grid.nsizes ? grid.sizes : defaultGemvSizes;
+
+    for (int w = 0; w < grid.nworkers; w++) {
+        for (int i = 0; i < nGemm; i++) benchGemm(&suite, (int)gemmSizes[i], grid.workers[w]);
+        for (int i = 0; i < nGemv; i++) benchGemv(&suite, (int)gemvSizes[i], grid.workers[w]);
+    }
+
+    microFinish(&suite, RESULTS_DIR);
+    return 0;
+}
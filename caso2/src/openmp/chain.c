@@ -0,0 +1,279 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <omp.h>
+
+#include "chain.h"
+
+/* ==========================================
+ * Pool de buffers
+ * ========================================== */
+MatrixPool* createMatrixPool(int count, int rows, int cols) {
+    if (count < 1 || count > POOL_MAX_BUFFERS) {
+        fprintf(stderr, "Error: tamaño de pool inválido (%d)\n", count);
+        exit(EXIT_FAILURE);
+    }
+
+    MatrixPool* pool = (MatrixPool*)calloc(1, sizeof(MatrixPool));
+    if (pool == NULL) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para el pool\n");
+        exit(EXIT_FAILURE);
+    }
+    pool->count = count;
+    pool->cap_rows = rows;
+    pool->cap_cols = cols;
+
+    for (int b = 0; b < count; b++) {
+        int** M = (int**)malloc(rows * sizeof(int*));
+        if (M == NULL) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para el buffer %d\n", b);
+            exit(EXIT_FAILURE);
+        }
+        for (int i = 0; i < rows; i++) {
+            M[i] = (int*)calloc(cols, sizeof(int));
+            if (M[i] == NULL) {
+                fprintf(stderr, "Error: No se pudo asignar memoria para la fila %d\n", i);
+                exit(EXIT_FAILURE);
+            }
+        }
+        pool->buf[b] = M;
+    }
+    return pool;
+}
+
+int** poolAcquire(MatrixPool* pool) {
+    for (int b = 0; b < pool->count; b++) {
+        if (!pool->in_use[b]) {
+            pool->in_use[b] = 1;
+            return pool->buf[b];
+        }
+    }
+    fprintf(stderr, "Error: pool de matrices agotado (%d buffers)\n", pool->count);
+    exit(EXIT_FAILURE);
+}
+
+/* Ignora matrices que no pertenecen al pool (p. ej. operandos de entrada) */
+void poolRelease(MatrixPool* pool, int** M) {
+    for (int b = 0; b < pool->count; b++) {
+        if (pool->buf[b] == M) {
+            pool->in_use[b] = 0;
+            return;
+        }
+    }
+}
+
+void freeMatrixPool(MatrixPool* pool) {
+    if (pool == NULL) return;
+    for (int b = 0; b < pool->count; b++) {
+        for (int i = 0; i < pool->cap_rows; i++) free(pool->buf[b][i]);
+        free(pool->buf[b]);
+    }
+    free(pool);
+}
+
+/* ==========================================
+ * Multiplicación rectangular
+ * ========================================== */
+void multiplyRectOMP(int** A, int** B, int** C, int r, int k, int c, int threads) {
+    #pragma omp parallel for schedule(static) num_threads(threads)
+    for (int i = 0; i < r; i++) {
+        unsigned* restrict ci = (unsigned*)C[i];
+        memset(ci, 0, c * sizeof(int));
+        for (int p = 0; p < k; p++) {
+            const unsigned temp = (unsigned)A[i][p];
+            const unsigned* restrict bp = (const unsigned*)B[p];
+            for (int j = 0; j < c; j++)
+                ci[j] += temp * bp[j];
+        }
+    }
+}
+
+/* ==========================================
+ * Potencia por cuadrados sucesivos
+ * ==========================================
+ * Tres buffers: base P (se eleva al cuadrado), acumulado R y temporal T.
+ * Cada producto escribe en T y luego se intercambian punteros. El primer
+ * bit en 1 no copia: R se queda con el buffer de P, y el cuadrado
+ * siguiente deja P en T y toma el tercer buffer como temporal.
+ */
+int** matrixPowerOMP(MatrixPool* pool, int** A, int n, int k, int threads, int* steps) {
+    int** P = A;
+    int** R = NULL;
+    int** T = poolAcquire(pool);
+    *steps = 0;
+
+    while (k > 0) {
+        if (k & 1) {
+            if (R == NULL) {
+                R = P;
+            } else {
+                multiplyRectOMP(R, P, T, n, n, n, threads);
+                int** tmp = R; R = T; T = tmp;
+                (*steps)++;
+            }
+        }
+        k >>= 1;
+        if (k > 0) {
+            multiplyRectOMP(P, P, T, n, n, n, threads);
+            int** old = P; P = T;
+            T = (old == R) ? poolAcquire(pool) : old;
+            (*steps)++;
+        }
+    }
+
+    if (P != R) poolRelease(pool, P);
+    poolRelease(pool, T);
+    return R;
+}
+
+/* ==========================================
+ * Orden de la cadena (programación dinámica)
+ * ========================================== */
+ChainPlan* planMatrixChain(const int* dims, int m) {
+    ChainPlan* plan = (ChainPlan*)malloc(sizeof(ChainPlan));
+    long long* cost = (long long*)calloc((size_t)m * m, sizeof(long long));
+    if (plan == NULL || cost == NULL) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para el plan de la cadena\n");
+        exit(EXIT_FAILURE);
+    }
+    plan->m = m;
+    plan->dims = (int*)malloc((m + 1) * sizeof(int));
+    plan->split = (int*)calloc((size_t)m * m, sizeof(int));
+    if (plan->dims == NULL || plan->split == NULL) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para el plan de la cadena\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(plan->dims, dims, (m + 1) * sizeof(int));
+
+    for (int len = 2; len <= m; len++) {
+        for (int i = 0; i + len - 1 < m; i++) {
+            int j = i + len - 1;
+            cost[i * m + j] = LLONG_MAX;
+            for (int s = i; s < j; s++) {
+                long long c = cost[i * m + s] + cost[(s + 1) * m + j]
+                            + (long long)dims[i] * dims[s + 1] * dims[j + 1];
+                if (c < cost[i * m + j]) {
+                    cost[i * m + j] = c;
+                    plan->split[i * m + j] = s;
+                }
+            }
+        }
+    }
+
+    plan->cost = cost[m - 1];
+    free(cost);
+    return plan;
+}
+
+void freeChainPlan(ChainPlan* plan) {
+    if (plan == NULL) return;
+    free(plan->dims);
+    free(plan->split);
+    free(plan);
+}
+
+/* Buffers vivos en el pico al evaluar (i..j); los operandos de entrada
+ * no cuentan porque no salen del pool. */
+static int subchainNeed(const ChainPlan* plan, int i, int j) {
+    if (i == j) return 0;
+    int s = plan->split[i * plan->m + j];
+    int needL = subchainNeed(plan, i, s);
+    int needR = subchainNeed(plan, s + 1, j);
+    int heldL = (s > i);
+    int heldR = (j > s + 1);
+
+    /* Se evalúa primero el lado que más buffers necesita */
+    int peakL = (needL >= needR) ? needL : heldR + needL;
+    int peakR = (needL >= needR) ? heldL + needR : needR;
+    int peak = peakL > peakR ? peakL : peakR;
+    int out = heldL + heldR + 1;
+    return peak > out ? peak : out;
+}
+
+int chainBuffersNeeded(const ChainPlan* plan) {
+    return subchainNeed(plan, 0, plan->m - 1);
+}
+
+/* Cada producto (i..j) del árbol deja un intermedio de d[i] x d[j+1] */
+static void subchainExtent(const ChainPlan* plan, int i, int j, int* rows, int* cols) {
+    if (i == j) return;
+    int s = plan->split[i * plan->m + j];
+    const int* d = plan->dims;
+    if (d[i] > *rows) *rows = d[i];
+    if (d[j + 1] > *cols) *cols = d[j + 1];
+    subchainExtent(plan, i, s, rows, cols);
+    subchainExtent(plan, s + 1, j, rows, cols);
+}
+
+void chainBufferShape(const ChainPlan* plan, int* rows, int* cols) {
+    *rows = 0;
+    *cols = 0;
+    subchainExtent(plan, 0, plan->m - 1, rows, cols);
+}
+
+static void appendParens(const ChainPlan* plan, int i, int j, char* out, size_t len) {
+    size_t used = strlen(out);
+    if (used + 8 >= len) return;
+    if (i == j) {
+        snprintf(out + used, len - used, "A%d", i + 1);
+        return;
+    }
+    int s = plan->split[i * plan->m + j];
+    strncat(out, "(", len - used - 1);
+    appendParens(plan, i, s, out, len);
+    appendParens(plan, s + 1, j, out, len);
+    used = strlen(out);
+    strncat(out, ")", len - used - 1);
+}
+
+void chainParenthesization(const ChainPlan* plan, char* out, size_t len) {
+    out[0] = '\0';
+    appendParens(plan, 0, plan->m - 1, out, len);
+}
+
+static long long subchainOperations(const ChainPlan* plan, int i, int j) {
+    if (i == j) return 0;
+    int s = plan->split[i * plan->m + j];
+    const int* d = plan->dims;
+    return subchainOperations(plan, i, s) + subchainOperations(plan, s + 1, j)
+         + (long long)d[i] * d[j + 1] * (2LL * d[s + 1] - 1);
+}
+
+long long chainOperations(const ChainPlan* plan) {
+    return subchainOperations(plan, 0, plan->m - 1);
+}
+
+/* ==========================================
+ * Evaluación de la cadena
+ * ========================================== */
+static int** evaluateSubchain(int*** mats, const ChainPlan* plan, MatrixPool* pool,
+                              int i, int j, int threads, int* steps) {
+    if (i == j) return mats[i];
+
+    int s = plan->split[i * plan->m + j];
+    int** L;
+    int** R;
+    if (subchainNeed(plan, i, s) >= subchainNeed(plan, s + 1, j)) {
+        L = evaluateSubchain(mats, plan, pool, i, s, threads, steps);
+        R = evaluateSubchain(mats, plan, pool, s + 1, j, threads, steps);
+    } else {
+        R = evaluateSubchain(mats, plan, pool, s + 1, j, threads, steps);
+        L = evaluateSubchain(mats, plan, pool, i, s, threads, steps);
+    }
+
+    const int* d = plan->dims;
+    int** C = poolAcquire(pool);
+    multiplyRectOMP(L, R, C, d[i], d[s + 1], d[j + 1], threads);
+    (*steps)++;
+
+    poolRelease(pool, L);
+    poolRelease(pool, R);
+    return C;
+}
+
+int** multiplyChainOMP(int*** mats, const ChainPlan* plan, MatrixPool* pool,
+                       int threads, int* steps) {
+    *steps = 0;
+    return evaluateSubchain(mats, plan, pool, 0, plan->m - 1, threads, steps);
+}
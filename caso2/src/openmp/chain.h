@@ -0,0 +1,57 @@
+#ifndef CHAIN_H
+#define CHAIN_H
+
+/* ==========================================
+ * Potencias y cadenas de multiplicaciones
+ * ==========================================
+ * Todos los intermedios salen de un pool de buffers reservado antes de
+ * empezar: entre pasos no hay malloc/free, solo se intercambian punteros.
+ * La aritmética es módulo 2^32 (las potencias desbordan int enseguida).
+ */
+#define POOL_MAX_BUFFERS 32
+
+typedef struct {
+    int** buf[POOL_MAX_BUFFERS];
+    int in_use[POOL_MAX_BUFFERS];
+    int count;
+    int cap_rows;
+    int cap_cols;
+} MatrixPool;
+
+MatrixPool* createMatrixPool(int count, int rows, int cols);
+int** poolAcquire(MatrixPool* pool);
+void poolRelease(MatrixPool* pool, int** M);
+void freeMatrixPool(MatrixPool* pool);
+
+/* C (r x c) = A (r x k) · B (k x c) */
+void multiplyRectOMP(int** A, int** B, int** C, int r, int k, int c, int threads);
+
+/* A^k por cuadrados sucesivos. A debe ser un buffer del pool (de 3
+ * buffers); el resultado es un buffer del pool (el mismo A si k = 1). */
+int** matrixPowerOMP(MatrixPool* pool, int** A, int n, int k, int threads, int* steps);
+
+/* Orden óptimo de A1·A2·…·Am por programación dinámica sobre dims
+ * (Ai es dims[i-1] x dims[i]). */
+typedef struct {
+    int m;
+    int* dims;          // m + 1 dimensiones
+    int* split;         // m x m, k óptimo para (i, j)
+    long long cost;     // multiplicaciones escalares del orden óptimo
+} ChainPlan;
+
+ChainPlan* planMatrixChain(const int* dims, int m);
+void freeChainPlan(ChainPlan* plan);
+
+/* Buffers del pool necesarios para evaluar el plan (etiquetado de
+ * Sethi-Ullman sobre el árbol de paréntesis) */
+int chainBuffersNeeded(const ChainPlan* plan);
+/* Filas y columnas que debe admitir cada buffer: las máximas entre los
+ * intermedios del plan, no entre las entradas (dims 10,2000,10,2000 -> 10x2000) */
+void chainBufferShape(const ChainPlan* plan, int* rows, int* cols);
+void chainParenthesization(const ChainPlan* plan, char* out, size_t len);
+long long chainOperations(const ChainPlan* plan);
+
+int** multiplyChainOMP(int*** mats, const ChainPlan* plan, MatrixPool* pool,
+                       int threads, int* steps);
+
+#endif
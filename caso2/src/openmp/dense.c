@@ -0,0 +1,60 @@
+#include <stddef.h>
+#include <omp.h>
+
+#include "dense.h"
+#include "hpcbench.h"
+#include "trace.h"
+
+/* Máximo de filas de C por bloque en la ruta densa genérica (un "tile" en la traza) */
+#define ROW_TILE 16
+
+/* ==========================================
+ * Multiplicación con OpenMP
+ * ========================================== */
+/* Cada hilo toma bloques de ROW_TILE filas completas de C: ninguna fila se
+ * reparte entre hilos (con collapse(2) sobre i,k dos hilos podían sumar a
+ * la misma C[i][j] en el borde de sus rangos). Con `times` distinto de
+ * NULL cada hilo anota cuándo empieza y termina su parte. */
+void multiplyMatricesOMP(int** A, int** B, int** C, int size, int threads, WorkerTimes* times) {
+    /* Con matrices chicas el bloque se achica para que alcance para todos */
+    int tile = size / (threads * 4);
+    if (tile > ROW_TILE) tile = ROW_TILE;
+    if (tile < 1) tile = 1;
+
+    #pragma omp parallel num_threads(threads) shared(A, B, C)
+    {
+        TRACE_THREAD_NAME("omp %d", omp_get_thread_num());
+        TRACE_BEGIN("worker");
+        if (times != NULL) times->start[omp_get_thread_num()] = benchNow();
+        #pragma omp for schedule(static) nowait
+        for (int i0 = 0; i0 < size; i0 += tile) {
+            TRACE_BEGIN_ARG("tile", i0);
+            const int iEnd = i0 + tile < size ? i0 + tile : size;
+            for (int i = i0; i < iEnd; i++) {
+                for (int k = 0; k < size; k++) {
+                    int temp = A[i][k];
+                    for (int j = 0; j < size; j++) {
+                        C[i][j] += temp * B[k][j];
+                    }
+                }
+            }
+            TRACE_END("tile");
+        }
+        if (times != NULL) times->end[omp_get_thread_num()] = benchNow();
+        TRACE_END("worker");
+    }
+}
+
+/* ==========================================
+ * Referencia secuencial
+ * ========================================== */
+void multiplyMatricesSerial(int** A, int** B, int** C, int size) {
+    for (int i = 0; i < size; i++) {
+        for (int k = 0; k < size; k++) {
+            int temp = A[i][k];
+            for (int j = 0; j < size; j++) {
+                C[i][j] += temp * B[k][j];
+            }
+        }
+    }
+}
@@ -0,0 +1,18 @@
+#ifndef DENSE_H
+#define DENSE_H
+
+#include "scaling.h"
+
+/* ==========================================
+ * Multiplicación densa genérica (C += A·B)
+ * ==========================================
+ * Ruta para cualquier tamaño sin kernel especializado (fixedKernels.h).
+ * Vive aparte de matrixOpenMp.c para que el microbenchmark la enlace tal
+ * cual la usa el programa.
+ */
+void multiplyMatricesOMP(int** A, int** B, int** C, int size, int threads, WorkerTimes* times);
+
+/* Referencia en un solo hilo, sin OpenMP, para verificar los kernels */
+void multiplyMatricesSerial(int** A, int** B, int** C, int size);
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef FIXED_KERNELS_H
+#define FIXED_KERNELS_H
+
+#include <string.h>
+
+/* ==========================================
+ * Kernels especializados para tamaños fijos
+ * ==========================================
+ * Con `size` conocido en tiempo de compilación el compilador puede
+ * desenrollar por completo el bucle interno y mantener la fila de C
+ * en registros vectoriales. Los kernels se generan con macros para la
+ * lista de tamaños FIXED_KERNEL_SIZES (múltiplos de 8), configurable
+ * desde el Makefile:
+ *
+ *   make FIXED_SIZES="16 32 64 128"
+ */
+#ifndef FIXED_KERNEL_SIZES
+#define FIXED_KERNEL_SIZES(X) X(16) X(32) X(64)
+#endif
+
+typedef void (*FixedKernelFn)(int** A, int** B, int** C, int threads);
+
+typedef struct {
+    int size;
+    FixedKernelFn fn;
+} FixedKernel;
+
+/* Vector de 8 enteros (extensión de GCC): el compilador lo baja a AVX2,
+ * AVX-512 o SSE según -march, sin intrínsecos explícitos. */
+typedef int FixedVec __attribute__((vector_size(32)));
+
+/* Cada fila de C se acumula en N/8 registros vectoriales que se escriben
+ * una sola vez al final; el bucle sobre j queda totalmente desenrollado. */
+#define DEFINE_FIXED_KERNEL(N)                                              \
+_Static_assert((N) % 8 == 0, "FIXED_KERNEL_SIZES: N debe ser múltiplo de 8"); \
+static void multiplyFixed##N(int** A, int** B, int** C, int threads) {      \
+    _Pragma("omp parallel for num_threads(threads) schedule(static)")       \
+    for (int i = 0; i < N; i++) {                                           \
+        FixedVec acc[N / 8];                                                \
+        memset(acc, 0, sizeof(acc));                                        \
+        const int* a = A[i];                                                \
+        for (int k = 0; k < N; k++) {                                       \
+            const FixedVec t = (FixedVec){0} + a[k];                        \
+            const int* b = B[k];                                            \
+            for (int j = 0; j < N / 8; j++) {                               \
+                FixedVec bv;                                                \
+                memcpy(&bv, b + 8 * j, sizeof(bv));                         \
+                acc[j] += t * bv;                                           \
+            }                                                               \
+        }                                                                   \
+        int* c = C[i];                                                      \
+        for (int j = 0; j < N / 8; j++) {                                   \
+            FixedVec cv;                                                    \
+            memcpy(&cv, c + 8 * j, sizeof(cv));                             \
+            cv += acc[j];                                                   \
+            memcpy(c + 8 * j, &cv, sizeof(cv));                             \
+        }                                                                   \
+    }                                                                       \
+}
+
+FIXED_KERNEL_SIZES(DEFINE_FIXED_KERNEL)
+
+#define FIXED_KERNEL_ENTRY(N) { N, multiplyFixed##N },
+
+static const FixedKernel fixedKernels[] = {
+    FIXED_KERNEL_SIZES(FIXED_KERNEL_ENTRY)
+};
+
+/* Devuelve el kernel especializado para `size`, o NULL si no existe. */
+static inline FixedKernelFn findFixedKernel(int size) {
+    for (size_t i = 0; i < sizeof(fixedKernels) / sizeof(fixedKernels[0]); i++)
+        if (fixedKernels[i].size == size) return fixedKernels[i].fn;
+    return NULL;
+}
+
+#endif
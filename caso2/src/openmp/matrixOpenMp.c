@@ -1,66 +1,75 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
-#include <sys/time.h>
-#include <sys/resource.h>
-#include <sys/stat.h>
 #include <string.h>
-#include <errno.h>
 #include <omp.h>
 
+#include "perfCounters.h"
+#include "csvUtils.h"
+#include "roofline.h"
+#include "hpcbench.h"
+#include "trace.h"
+#include "scaling.h"
+#include "memTrack.h"
+#include "fixedKernels.h"
+#include "sparse.h"
+#include "matvec.h"
+#include "chain.h"
+#include "dense.h"
+
 #ifndef RESULTS_DIR
 #define RESULTS_DIR "results"
 #endif
 
 #define DATA_DIR RESULTS_DIR "/OpenMp_Data"
+#define SPARSE_DATA_DIR RESULTS_DIR "/Sparse_Data"
+#define MATVEC_DATA_DIR RESULTS_DIR "/MatVec_Data"
+#define CHAIN_DATA_DIR RESULTS_DIR "/Chain_Data"
+#define ROOFLINE_DIR RESULTS_DIR "/Roofline_Data"
 
-/* ==========================================
- * Estructura de métricas de rendimiento
- * ========================================== */
-typedef struct {
-    double real_time;
-    double user_time;
-    double system_time;
-    double total_cpu_time;
-    long long total_operations;
-    double gops;
-    double elements_per_second;
-    size_t memory_used;
-} PerformanceStats;
+#define CHAIN_MAX_MATRICES 64
 
-/* ==========================================
- * Funciones auxiliares de directorios y CSV
- * ========================================== */
-void createDirectoryIfNotExists(const char* dirPath) {
-    if (dirPath == NULL || *dirPath == '\0') return;
+/* Densidad por debajo de la cual un operando se trata como disperso */
+#ifndef SPARSE_THRESHOLD
+#define SPARSE_THRESHOLD 0.05
+#endif
 
-    char tmp[1024];
-    size_t len = strlen(dirPath);
-    if (len >= sizeof(tmp)) {
-        fprintf(stderr, "Error: ruta demasiado larga: %s\n", dirPath);
-        exit(EXIT_FAILURE);
-    }
+/* Contadores de hardware: se abren en main antes de crear hilos para que
+ * `inherit` cubra también el pool de OpenMP */
+static PerfCounters perfCounters;
 
-    strcpy(tmp, dirPath);
-    if (tmp[len - 1] == '/') tmp[len - 1] = '\0';
+/* Calentamientos y repeticiones de cada región medida (BENCH_WARMUP/BENCH_REPS) */
+static BenchConfig benchConfig;
 
-    for (char *p = tmp + 1; *p; p++) {
-        if (*p == '/') {
-            *p = '\0';
-            if (mkdir(tmp, 0700) != 0 && errno != EEXIST) {
-                fprintf(stderr, "Error creando directorio '%s': %s\n", tmp, strerror(errno));
-                exit(EXIT_FAILURE);
-            }
-            *p = '/';
-        }
-    }
+/* ==========================================
+ * Opciones de línea de comandos
+ * ========================================== */
+typedef enum {
+    MODE_GEMM,
+    MODE_GEMV,
+    MODE_SPMV,
+    MODE_POWER,
+    MODE_CHAIN
+} BenchMode;
 
-    if (mkdir(tmp, 0700) != 0 && errno != EEXIST) {
-        fprintf(stderr, "Error creando directorio '%s': %s\n", tmp, strerror(errno));
-        exit(EXIT_FAILURE);
-    }
-}
+typedef struct {
+    BenchMode mode;
+    int size;
+    int threads;
+    int streaming;          // prefetch no temporal en GEMV/SpMV
+    int saveMatrices;
+    int forceGeneric;
+    double density_a;       // 1.0 = matriz densa (createMatrix)
+    double density_b;
+    double threshold;       // densidad máxima para usar formato disperso
+    int power;              // exponente k de A^k (mode=power)
+    int chain_len;          // número de matrices de la cadena (mode=chain)
+    int chain_dims[CHAIN_MAX_MATRICES + 1];
+} Options;
 
+/* ==========================================
+ * Funciones auxiliares de CSV
+ * ========================================== */
 char* generateFilename(const char* dirPath) {
     char* filename = (char*)malloc(256);
     if (filename == NULL) {
@@ -71,48 +80,49 @@ char* generateFilename(const char* dirPath) {
     return filename;
 }
 
-void writeCSVHeaderIfNotExists(const char* filename) {
-    struct stat st;
-    if (stat(filename, &st) != 0) {
-        FILE* file = fopen(filename, "w");
-        if (file == NULL) {
-            fprintf(stderr, "Error: No se pudo crear el archivo CSV %s\n", filename);
-            exit(EXIT_FAILURE);
-        }
-        fprintf(file,
-            "size,threads,real_time,user_time,system_time,total_cpu_time,"
-            "total_operations,gops,elements_per_second_millions,memory_used_mb,algorithm\n");
-        fclose(file);
-    }
+/* Columnas de los CSV de resultados. Hasta la primera columna que no es
+ * de hpcbench (algorithm) las llena benchLegacyRow; el resto, cada modo */
+#define TIMING_COLUMNS "size,threads,real_time,user_time,system_time,total_cpu_time," \
+                       "total_operations,gops,"
+#define RESULTS_COLUMNS TIMING_COLUMNS "elements_per_second_millions,memory_used_mb,algorithm," \
+                        PERF_CSV_HEADER
+#define SPARSE_COLUMNS TIMING_COLUMNS "elements_per_second_millions,memory_used_mb,algorithm," \
+                       "density_a,density_b," PERF_CSV_HEADER
+#define MATVEC_COLUMNS TIMING_COLUMNS "bandwidth_gbs,bytes_moved,memory_used_mb,algorithm,density," \
+                       PERF_CSV_HEADER
+#define CHAIN_COLUMNS TIMING_COLUMNS "elements_per_second_millions,memory_used_mb,algorithm," \
+                      "steps,buffers,order," PERF_CSV_HEADER
+
+/* Agrega una fila a `filename`; `extra` son las columnas propias del modo
+ * desde algorithm, cada una con su coma */
+void appendResultRow(const char* filename, const char* columns, const BenchRecord* rec,
+                     const BenchRun* run, const char* extra) {
+    FILE* file = benchLegacyRow(filename, columns, rec, run);
+    if (file == NULL) return;
+    fputs(extra, file);
+    perfCountersWriteCSV(file, &perfCounters);
+    benchLegacyEnd(file);
 }
 
-void writeResultsToCSV(const char* filename, int size, int threads, PerformanceStats stats, const char* algorithm) {
+/* CSV con la comparación kernel especializado vs. ruta genérica */
+void writeFixedKernelCSV(const char* dirPath, int size, int threads,
+                         double generic_time, double fixed_time) {
+    char filename[512];
+    snprintf(filename, sizeof(filename), "%s/FixedKernels_Results.csv", dirPath);
+    ensureCSVHeader(filename, "size,threads,generic_time,fixed_time,speedup");
+
     FILE* file = fopen(filename, "a");
     if (file == NULL) {
-        fprintf(stderr, "Error: No se pudo abrir el archivo CSV para escritura\n");
+        fprintf(stderr, "Error: No se pudo abrir el archivo CSV %s\n", filename);
         return;
     }
 
-    fprintf(file, "%d,%d,%.9f,%.9f,%.9f,%.9f,%lld,%.6f,%.6f,%lu,%s\n",
-        size,
-        threads,
-        stats.real_time,
-        stats.user_time,
-        stats.system_time,
-        stats.total_cpu_time,
-        stats.total_operations,
-        stats.gops,
-        stats.elements_per_second,
-        stats.memory_used,
-        algorithm);
-
+    fprintf(file, "%d,%d,%.9f,%.9f,%.6f\n",
+        size, threads, generic_time, fixed_time,
+        fixed_time > 1e-12 ? generic_time / fixed_time : 0.0);
     fclose(file);
 }
 
-double timeval_to_seconds(struct timeval tv) {
-    return tv.tv_sec + (tv.tv_usec / 1000000.0);
-}
-
 /* ==========================================
  * Funciones de manejo de matrices
  * ========================================== */
@@ -156,24 +166,42 @@ int** createResultMatrix(int size) {
     return C;
 }
 
+int* createVector(int size) {
+    int* v = (int*)malloc(size * sizeof(int));
+    if (v == NULL) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para el vector\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < size; i++)
+        v[i] = rand() % 100 + 1;
+    return v;
+}
+
+int** createRectMatrix(int rows, int cols) {
+    int** M = (int**)malloc(rows * sizeof(int*));
+    if (M == NULL) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para la matriz\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < rows; i++) {
+        M[i] = (int*)malloc(cols * sizeof(int));
+        if (M[i] == NULL) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para la fila %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+        for (int j = 0; j < cols; j++)
+            M[i][j] = rand() % 100 + 1;
+    }
+    return M;
+}
+
 void freeMatrix(int** M, int size) {
     for (int i = 0; i < size; i++) free(M[i]);
     free(M);
 }
 
-/* ==========================================
- * Multiplicación con OpenMP
- * ========================================== */
-void multiplyMatricesOMP(int** A, int** B, int** C, int size, int threads) {
-    #pragma omp parallel for collapse(2) num_threads(threads) shared(A, B, C)
-    for (int i = 0; i < size; i++) {
-        for (int k = 0; k < size; k++) {
-            int temp = A[i][k];
-            for (int j = 0; j < size; j++) {
-                C[i][j] += temp * B[k][j];
-            }
-        }
-    }
+void clearMatrix(int** M, int size) {
+    for (int i = 0; i < size; i++) memset(M[i], 0, size * sizeof(int));
 }
 
 /* ==========================================
@@ -202,93 +230,703 @@ void saveMatrixCSV(const char* dir, const char* name, int** M, int size) {
 }
 
 /* ==========================================
- * Programa principal
+ * Métricas derivadas y reporte
  * ========================================== */
-int main(int argc, char* argv[]) {
-    if (argc < 3) {
-        fprintf(stderr, "Uso: %s <tamaño_matriz> <num_hilos> [save]\n", argv[0]);
-        return EXIT_FAILURE;
+/* Registro de una corrida: `ops` por repetición y `bytes`, el tráfico mínimo
+ * de memoria (roofline y ancho de banda). Elementos: los size x size de C */
+BenchRecord makeRecord(const char* algorithm, int size, int threads, double ops, double bytes) {
+    BenchRecord record = { "caso2", "openmp_opt", algorithm, size, threads,
+                           ops, (double)size * size, bytes };
+    return record;
+}
+
+void printStats(const BenchRecord* rec, const BenchRun* run) {
+    printf("\n===== RESULTADOS OPENMP =====\n");
+    printf("Tamaño de la matriz: %ld x %ld\n", rec->size, rec->size);
+    printf("Hilos utilizados: %d\n", rec->workers);
+    benchPrintRecord(rec, run);
+    perfCountersPrint(&perfCounters);
+}
+
+/* Roofline (ROOFLINE=1) con el tiempo de run y el tráfico de rec */
+void reportRoofline(const BenchRecord* rec, const BenchRun* run) {
+    rooflineReport(ROOFLINE_DIR, rec->variant, (int)rec->size, rec->workers, ROOFLINE_INT,
+                   rec->ops, rec->bytes, &run->summary, &perfCounters);
+}
+
+void saveMatricesCSV(int** A, int** B, int** C, int size) {
+    printf("Guardando matrices en CSV...\n");
+    benchEnsureDir(DATA_DIR "/matrices");
+    saveMatrixCSV(DATA_DIR "/matrices", "A", A, size);
+    saveMatrixCSV(DATA_DIR "/matrices", "B", B, size);
+    saveMatrixCSV(DATA_DIR "/matrices", "C_resultado", C, size);
+}
+
+/* ==========================================
+ * Modo disperso
+ * ==========================================
+ * Los operandos se generan en CSR con la densidad pedida. Según el
+ * umbral se elige:
+ *   A y B dispersas -> SpGEMM de Gustavson (CSR x CSR)
+ *   solo A dispersa -> SpMM (CSR x densa)
+ *   solo B dispersa -> densa x CSC
+ *   ninguna         -> multiplicación densa habitual
+ */
+int runSparseBenchmark(const Options* opt) {
+    int size = opt->size;
+    int threads = opt->threads;
+    int sparseA = opt->density_a <= opt->threshold;
+    int sparseB = opt->density_b <= opt->threshold;
+
+    benchEnsureDir(SPARSE_DATA_DIR);
+
+    printf("Creando matrices de %dx%d (densidad A=%.4f, B=%.4f)...\n",
+           size, size, opt->density_a, opt->density_b);
+    SparseMatrix* As = createSparseMatrix(size, opt->density_a);
+    SparseMatrix* Bs = createSparseMatrix(size, opt->density_b);
+    printf("No nulos: A=%ld, B=%ld\n", As->nnz, Bs->nnz);
+
+    /* Operandos en el formato que necesita cada ruta (fuera del tiempo) */
+    int** A = NULL;
+    int** B = NULL;
+    SparseMatrix* Bcsc = NULL;
+    if (!sparseA) { A = createResultMatrix(size); csrToDense(As, A); }
+    if (!sparseB) { B = createResultMatrix(size); csrToDense(Bs, B); }
+    if (sparseB && !sparseA) Bcsc = csrToCsc(Bs);
+
+    int** C = NULL;
+    SparseMatrix* Cs = NULL;
+    if (!(sparseA && sparseB)) C = createResultMatrix(size);
+
+    const char* algorithm;
+    long long total_operations;
+    if (sparseA && sparseB) {
+        algorithm = "openmp_spgemm";
+        total_operations = 2 * spgemmFlops(As, Bs);
+    } else if (sparseA) {
+        algorithm = "openmp_spmm";
+        total_operations = 2LL * As->nnz * size;
+    } else if (sparseB) {
+        algorithm = "openmp_dense_csc";
+        total_operations = 2LL * Bs->nnz * size;
+    } else {
+        algorithm = "openmp";
+        total_operations = (long long)size * size * (2 * size - 1);
+    }
+    printf("Ruta seleccionada: %s (umbral de densidad %.4f), %d hilos\n",
+           algorithm, opt->threshold, threads);
+
+    BenchRun run;
+    benchRunInit(&run, &benchConfig);
+    perfCountersReset(&perfCounters);
+
+    while (benchRunNext(&run)) {
+        /* Las rutas densas acumulan en C y SpGEMM crea C nueva */
+        if (C != NULL) clearMatrix(C, size);
+        freeSparseMatrix(Cs);
+        Cs = NULL;
+
+        perfCountersStart(&perfCounters);
+        benchStart(&run);
+
+        if (sparseA && sparseB)
+            Cs = spgemmOMP(As, Bs, threads);
+        else if (sparseA)
+            spmmOMP(As, B, C, threads);
+        else if (sparseB)
+            denseTimesCscOMP(A, Bcsc, C, threads);
+        else
+            multiplyMatricesOMP(A, B, C, size, threads, NULL);
+
+        benchStop(&run);
+        perfCountersStop(&perfCounters);
+        if (!benchIsWarmup(&run)) perfCountersAccumulate(&perfCounters);
     }
 
-    int size = atoi(argv[1]);
-    int threads = atoi(argv[2]);
-    int saveMatrices = (argc >= 4 && strcmp(argv[3], "save") == 0);
+    benchRunFinish(&run);
+
+    /* CSR: índice + valor por no nulo más los desplazamientos de fila */
+    double dense = (double)size * size * sizeof(int);
+    double csrRow = (size + 1.0) * sizeof(long);
+    double bytes = (sparseA ? As->nnz * 2.0 * sizeof(int) + csrRow : dense)
+                 + (sparseB ? Bs->nnz * 2.0 * sizeof(int) + csrRow : dense)
+                 + (Cs != NULL ? Cs->nnz * 2.0 * sizeof(int) + csrRow : dense);
+    BenchRecord record = makeRecord(algorithm, size, threads, (double)total_operations, bytes);
+
+    char extra[128];
+    snprintf(extra, sizeof(extra), "%s,%.6f,%.6f,", algorithm, opt->density_a, opt->density_b);
+    appendResultRow(SPARSE_DATA_DIR "/Sparse_Results.csv", SPARSE_COLUMNS, &record, &run, extra);
+    benchWriteUnified(RESULTS_DIR, &record, &run);
+
+    printStats(&record, &run);
+    if (Cs != NULL) printf("No nulos en C: %ld\n", Cs->nnz);
+    printf("Datos guardados en: %s/Sparse_Results.csv\n", SPARSE_DATA_DIR);
+    reportRoofline(&record, &run);
+
+    if (opt->saveMatrices) {
+        if (A == NULL) { A = createResultMatrix(size); csrToDense(As, A); }
+        if (B == NULL) { B = createResultMatrix(size); csrToDense(Bs, B); }
+        if (C == NULL) { C = createResultMatrix(size); csrToDense(Cs, C); }
+        saveMatricesCSV(A, B, C, size);
+    }
 
-    if (size <= 0 || threads <= 0) {
-        fprintf(stderr, "Error: tamaño y número de hilos deben ser positivos.\n");
+    if (A != NULL) freeMatrix(A, size);
+    if (B != NULL) freeMatrix(B, size);
+    if (C != NULL) freeMatrix(C, size);
+    freeSparseMatrix(As);
+    freeSparseMatrix(Bs);
+    freeSparseMatrix(Bcsc);
+    freeSparseMatrix(Cs);
+    benchRunFree(&run);
+
+    return EXIT_SUCCESS;
+}
+
+/* ==========================================
+ * Modo matriz-vector (GEMV / SpMV)
+ * ==========================================
+ * Reutiliza la generación de matrices (densa o CSR) y mide el kernel
+ * y = A·x. El resultado interesante es el ancho de banda logrado.
+ */
+int runMatVecBenchmark(const Options* opt) {
+    int size = opt->size;
+    int threads = opt->threads;
+    int sparse = (opt->mode == MODE_SPMV);
+    double density = sparse ? opt->density_a : 1.0;
+
+    benchEnsureDir(MATVEC_DATA_DIR);
+
+    int** A = NULL;
+    SparseMatrix* As = NULL;
+    printf("Creando matriz de %dx%d y vector...\n", size, size);
+    if (sparse) {
+        As = createSparseMatrix(size, density);
+        printf("No nulos: %ld (densidad %.4f)\n", As->nnz, density);
+    } else {
+        A = createMatrix(size);
+    }
+    int* x = createVector(size);
+    int* y = (int*)calloc(size, sizeof(int));
+    if (y == NULL) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para el vector resultado\n");
         return EXIT_FAILURE;
     }
 
-    srand(time(NULL));
+    char algorithm[32];
+    snprintf(algorithm, sizeof(algorithm), "openmp_%s%s",
+             sparse ? "spmv" : "gemv", opt->streaming ? "_nt" : "");
 
-    createDirectoryIfNotExists(DATA_DIR);
-    char* csvFilename = generateFilename(DATA_DIR);
-    writeCSVHeaderIfNotExists(csvFilename);
+    long long total_operations;
+    long long bytes_moved;        // tráfico mínimo de memoria
+    if (sparse) {
+        total_operations = 2LL * As->nnz;
+        bytes_moved = spmvBytes(As);
+    } else {
+        total_operations = 2LL * size * size;
+        bytes_moved = gemvBytes(size);
+    }
 
-    printf("Creando matrices de %dx%d...\n", size, size);
-    int** A = createMatrix(size);
-    int** B = createMatrix(size);
-    int** C = createResultMatrix(size);
-    printf("Matrices creadas. Iniciando multiplicación con %d hilos...\n", threads);
+    /* Al menos un calentamiento: pool de hilos y primera escritura de y */
+    BenchConfig cfg = benchConfig;
+    if (cfg.warmup < 1) cfg.warmup = 1;
+    BenchRun run;
+    benchRunInit(&run, &cfg);
+    perfCountersReset(&perfCounters);
+
+    while (benchRunNext(&run)) {
+        perfCountersStart(&perfCounters);
+        benchStart(&run);
+
+        if (sparse) spmvOMP(As, x, y, threads, opt->streaming);
+        else gemvOMP(A, x, y, size, threads, opt->streaming);
 
-    PerformanceStats stats = {0};
-    struct rusage start_usage, end_usage;
-    struct timespec start_time, end_time;
+        benchStop(&run);
+        perfCountersStop(&perfCounters);
+        if (!benchIsWarmup(&run)) perfCountersAccumulate(&perfCounters);
+    }
+
+    benchRunFinish(&run);
+    BenchRecord record = makeRecord(algorithm, size, threads, (double)total_operations,
+                                    (double)bytes_moved);
 
-    getrusage(RUSAGE_SELF, &start_usage);
-    clock_gettime(CLOCK_MONOTONIC, &start_time);
+    char extra[64];
+    snprintf(extra, sizeof(extra), "%s,%.6f,", algorithm, density);
+    appendResultRow(MATVEC_DATA_DIR "/MatVec_Results.csv", MATVEC_COLUMNS, &record, &run, extra);
+    benchWriteUnified(RESULTS_DIR, &record, &run);
 
-    multiplyMatricesOMP(A, B, C, size, threads);
+    printf("Kernel: %s\n", algorithm);
+    printStats(&record, &run);
+    printf("Datos guardados en: %s/MatVec_Results.csv\n", MATVEC_DATA_DIR);
+    reportRoofline(&record, &run);
 
-    clock_gettime(CLOCK_MONOTONIC, &end_time);
-    getrusage(RUSAGE_SELF, &end_usage);
+    if (A != NULL) freeMatrix(A, size);
+    freeSparseMatrix(As);
+    free(x);
+    free(y);
+    benchRunFree(&run);
 
-    stats.real_time = (end_time.tv_sec - start_time.tv_sec) +
-                      (end_time.tv_nsec - start_time.tv_nsec) / 1e9;
+    return EXIT_SUCCESS;
+}
+
+/* ==========================================
+ * Modo potencia / cadena
+ * ==========================================
+ * power: A^k por cuadrados sucesivos con un pool de 3 matrices (A se
+ *        regenera en cada repetición directamente en uno de los buffers,
+ *        sin una cuarta matriz con el original).
+ * chain: A1·…·Am en el orden óptimo por programación dinámica; el pool
+ *        tiene los buffers que indica el árbol de paréntesis.
+ * En ambos casos todos los buffers se reservan antes de medir.
+ */
+/* Misma A en cada repetición: rand_r con la semilla fija de la corrida */
+static void fillPowerBase(int** A, int size, unsigned int seed) {
+    unsigned int state = seed;
+    for (int i = 0; i < size; i++)
+        for (int j = 0; j < size; j++)
+            A[i][j] = rand_r(&state) % 100 + 1;
+}
 
-    stats.user_time = timeval_to_seconds(end_usage.ru_utime) - timeval_to_seconds(start_usage.ru_utime);
-    stats.system_time = timeval_to_seconds(end_usage.ru_stime) - timeval_to_seconds(start_usage.ru_stime);
-    stats.total_cpu_time = stats.user_time + stats.system_time;
+int runChainBenchmark(const Options* opt) {
+    int threads = opt->threads;
+    int isPower = (opt->mode == MODE_POWER);
 
-    stats.total_operations = (long long)size * size * (2 * size - 1);
+    benchEnsureDir(CHAIN_DATA_DIR);
 
-    if (stats.real_time > 1e-9) {
-        stats.gops = (stats.total_operations / stats.real_time) / 1e9;
-        stats.elements_per_second = (double)(size * size) / stats.real_time / 1e6;
+    char algorithm[32];
+    char order[1024];
+    int steps = 0;
+    int buffers;
+    int size;
+    long long total_operations;
+
+    MatrixPool* pool;
+    ChainPlan* plan = NULL;
+    int** inputs[CHAIN_MAX_MATRICES];
+    unsigned int powerSeed = 0;
+
+    if (isPower) {
+        size = opt->size;
+        buffers = 3;
+        snprintf(algorithm, sizeof(algorithm), "openmp_power");
+        snprintf(order, sizeof(order), "A^%d", opt->power);
+
+        /* A^k destruye su entrada (los buffers rotan), así que cada
+         * repetición vuelve a generar A con la misma semilla */
+        printf("Creando pool de %d matrices de %dx%d...\n", buffers, size, size);
+        pool = createMatrixPool(buffers, size, size);
+        powerSeed = (unsigned int)rand();
     } else {
-        stats.gops = 0.0;
-        stats.elements_per_second = 0.0;
+        const int* d = opt->chain_dims;
+        int m = opt->chain_len;
+        plan = planMatrixChain(d, m);
+        buffers = chainBuffersNeeded(plan);
+        chainParenthesization(plan, order, sizeof(order));
+        snprintf(algorithm, sizeof(algorithm), "openmp_chain");
+
+        int maxRows, maxCols;
+        chainBufferShape(plan, &maxRows, &maxCols);
+        size = 0;
+        for (int i = 0; i <= m; i++)
+            if (d[i] > size) size = d[i];
+
+        printf("Creando %d matrices de entrada y pool de %d buffers (%dx%d)...\n",
+               m, buffers, maxRows, maxCols);
+        for (int i = 0; i < m; i++) inputs[i] = createRectMatrix(d[i], d[i + 1]);
+        pool = createMatrixPool(buffers, maxRows, maxCols);
+        printf("Orden óptimo: %s (%lld multiplicaciones escalares)\n", order, plan->cost);
     }
 
-    stats.memory_used = end_usage.ru_maxrss / 1024;
+    int** R = NULL;
+    BenchRun run;
+    benchRunInit(&run, &benchConfig);
+    perfCountersReset(&perfCounters);
+
+    while (benchRunNext(&run)) {
+        if (R != NULL) poolRelease(pool, R);
+        int** A = NULL;
+        if (isPower) {
+            A = poolAcquire(pool);
+            fillPowerBase(A, size, powerSeed);
+        }
+
+        perfCountersStart(&perfCounters);
+        benchStart(&run);
 
-    writeResultsToCSV(csvFilename, size, threads, stats, "openmp");
+        if (isPower)
+            R = matrixPowerOMP(pool, A, size, opt->power, threads, &steps);
+        else
+            R = multiplyChainOMP(inputs, plan, pool, threads, &steps);
 
-    printf("\n===== RESULTADOS OPENMP =====\n");
-    printf("Tamaño de la matriz: %d x %d\n", size, size);
-    printf("Hilos utilizados: %d\n", threads);
-    printf("Tiempo real: %.9f s\n", stats.real_time);
-    printf("Tiempo usuario: %.9f s\n", stats.user_time);
-    printf("Tiempo sistema: %.9f s\n", stats.system_time);
-    printf("Tiempo total CPU: %.9f s\n", stats.total_cpu_time);
-    printf("Total operaciones: %lld\n", stats.total_operations);
-    printf("Rendimiento: %.6f GOPS\n", stats.gops);
-    printf("Elementos/s: %.6f millones\n", stats.elements_per_second);
-    printf("Memoria usada: %lu MB\n", stats.memory_used);
+        benchStop(&run);
+        perfCountersStop(&perfCounters);
+        if (!benchIsWarmup(&run)) perfCountersAccumulate(&perfCounters);
+    }
+
+    total_operations = isPower ? (long long)steps * size * size * (2LL * size - 1)
+                               : chainOperations(plan);
+
+    benchRunFinish(&run);
+
+    /* Tráfico mínimo: leer las entradas y escribir el resultado una vez */
+    double bytes;
+    if (isPower) {
+        bytes = 2.0 * size * size * sizeof(int);
+    } else {
+        const int* d = opt->chain_dims;
+        int m = opt->chain_len;
+        bytes = (double)d[0] * d[m] * sizeof(int);
+        for (int i = 0; i < m; i++) bytes += (double)d[i] * d[i + 1] * sizeof(int);
+    }
+    BenchRecord record = makeRecord(algorithm, size, threads, (double)total_operations, bytes);
+
+    char extra[1100];
+    snprintf(extra, sizeof(extra), "%s,%d,%d,%s,", algorithm, steps, buffers, order);
+    appendResultRow(CHAIN_DATA_DIR "/Chain_Results.csv", CHAIN_COLUMNS, &record, &run, extra);
+    benchWriteUnified(RESULTS_DIR, &record, &run);
+
+    printf("Operación: %s (%d productos, %d buffers)\n", order, steps, buffers);
+    printStats(&record, &run);
+    printf("C[0][0] = %d\n", R[0][0]);
+    printf("Datos guardados en: %s/Chain_Results.csv\n", CHAIN_DATA_DIR);
+    reportRoofline(&record, &run);
+
+    if (!isPower) {
+        for (int i = 0; i < opt->chain_len; i++) freeMatrix(inputs[i], opt->chain_dims[i]);
+        freeChainPlan(plan);
+    }
+    freeMatrixPool(pool);
+    benchRunFree(&run);
+
+    return EXIT_SUCCESS;
+}
+
+/* ==========================================
+ * Modo denso (GEMM)
+ * ==========================================
+ * Mide C = A·B con la ruta genérica o el kernel especializado del
+ * tamaño. A, B y C pueden ser más grandes que `size` (barrido): se usa
+ * la esquina superior izquierda.
+ */
+int runDense(int** A, int** B, int** C, int size, int threads, int forceGeneric,
+             const BenchConfig* baseCfg, const char* csvFilename,
+             const char* samplesFile, ScalingStudy* scaling, int verbose) {
+    /* Kernel especializado si el tamaño está en FIXED_KERNEL_SIZES */
+    FixedKernelFn fixedKernel = forceGeneric ? NULL : findFixedKernel(size);
+    char algorithm[32] = "openmp";
+    double generic_time = 0.0;
+    int** C_ref = NULL;
+    BenchConfig cfg = *baseCfg;
+
+    if (fixedKernel != NULL) {
+        snprintf(algorithm, sizeof(algorithm), "openmp_fixed%d", size);
+        C_ref = createResultMatrix(size);
+
+        /* Ambos caminos con al menos un calentamiento (pool de hilos y caché) */
+        if (cfg.warmup < 1) cfg.warmup = 1;
+
+        /* Tiempo de la ruta genérica, para el speedup del kernel */
+        BenchRun genericRun;
+        benchRunInit(&genericRun, &cfg);
+        while (benchRunNext(&genericRun)) {
+            clearMatrix(C_ref, size);
+            benchStart(&genericRun);
+            multiplyMatricesOMP(A, B, C_ref, size, threads, NULL);
+            benchStop(&genericRun);
+        }
+        benchRunFinish(&genericRun);
+        generic_time = genericRun.summary.median;
+        benchRunFree(&genericRun);
+    }
+
+    /* Balance por hilo solo en la ruta genérica (los kernels fijos no se instrumentan) */
+    WorkerTimes times;
+    workerTimesInit(&times, threads, 0);
+
+    BenchRun run;
+    benchRunInit(&run, &cfg);
+    perfCountersReset(&perfCounters);
+
+    while (benchRunNext(&run)) {
+        clearMatrix(C, size);           // ambos kernels acumulan en C
+
+        perfCountersStart(&perfCounters);
+        benchStart(&run);
+
+        if (fixedKernel != NULL)
+            fixedKernel(A, B, C, threads);
+        else
+            multiplyMatricesOMP(A, B, C, size, threads, &times);
+
+        benchStop(&run);
+        perfCountersStop(&perfCounters);
+        if (!benchIsWarmup(&run)) perfCountersAccumulate(&perfCounters);
+        if (fixedKernel == NULL) workerTimesJoin(&times, &run);
+    }
+
+    benchRunFinish(&run);
+    BenchRecord record = makeRecord(algorithm, size, threads, (double)size * size * (2.0 * size - 1),
+                                    3.0 * size * size * sizeof(int));
+
+    if (C_ref != NULL) {
+        /* Se verifica contra la versión secuencial, no contra otra paralela */
+        clearMatrix(C_ref, size);
+        multiplyMatricesSerial(A, B, C_ref, size);
+        for (int i = 0; i < size; i++) {
+            if (memcmp(C[i], C_ref[i], size * sizeof(int)) != 0) {
+                fprintf(stderr, "Error: el kernel especializado difiere de la referencia secuencial (fila %d)\n", i);
+                freeMatrix(C_ref, size);
+                workerTimesFree(&times);
+                benchRunFree(&run);
+                return EXIT_FAILURE;
+            }
+        }
+        freeMatrix(C_ref, size);
+        writeFixedKernelCSV(DATA_DIR, size, threads, generic_time, run.summary.median);
+    }
+
+    char extra[40];
+    snprintf(extra, sizeof(extra), "%s,", algorithm);
+    appendResultRow(csvFilename, RESULTS_COLUMNS, &record, &run, extra);
+    benchWriteUnified(RESULTS_DIR, &record, &run);
+    if (samplesFile != NULL) benchWriteSamples(samplesFile, &record, &run);
+    scalingAdd(scaling, &record, &run, fixedKernel == NULL ? &times : NULL);
+    workerTimesFree(&times);
+
+    if (verbose) {
+        printStats(&record, &run);
+        if (fixedKernel != NULL) {
+            printf("Kernel especializado: %s (genérico: %.9f s, speedup: %.3fx)\n",
+                   algorithm, generic_time,
+                   run.summary.median > 1e-12 ? generic_time / run.summary.median : 0.0);
+        }
+        printf("Datos guardados en: %s\n", csvFilename);
+    } else {
+        printf("  tamaño %5d, %2d hilos: mediana %.6f s ± %.6f | %.3f GOPS (%s)\n",
+               size, threads, run.summary.median, run.summary.ci95, benchGops(&record, &run), algorithm);
+    }
+    reportRoofline(&record, &run);
+
+    benchRunFree(&run);
+    return EXIT_SUCCESS;
+}
+
+/* ==========================================
+ * Barrido (--sweep)
+ * ==========================================
+ * Todas las combinaciones tamaño x hilos en un solo proceso: las
+ * matrices se generan una vez con el tamaño máximo y el pool de hilos
+ * de OpenMP se reutiliza entre configuraciones. Cada configuración se
+ * agrega a los CSV apenas termina.
+ */
+int runSweep(const BenchSweep* sweep, int forceGeneric) {
+    int maxSize = (int)benchSweepMaxSize(sweep);
+
+    benchEnsureDir(DATA_DIR);
+    char* csvFilename = generateFilename(DATA_DIR);
+
+    printf("Creando matrices de %dx%d para el barrido...\n", maxSize, maxSize);
+    memTrackPhase("generacion");
+    int** A = createMatrix(maxSize);
+    int** B = createMatrix(maxSize);
+    int** C = createResultMatrix(maxSize);
+    memTrackPhase("calculo");
+    printf("Barrido: %d tamaños x %d configuraciones de hilos, %d repeticiones (+%d de calentamiento)\n",
+           sweep->nsizes, sweep->nworkers, benchConfigReps(&sweep->cfg), sweep->cfg.warmup);
+
+    ScalingStudy scaling;
+    scalingInit(&scaling);
+
+    int status = EXIT_SUCCESS;
+    for (int s = 0; s < sweep->nsizes && status == EXIT_SUCCESS; s++) {
+        for (int t = 0; t < sweep->nworkers && status == EXIT_SUCCESS; t++) {
+            status = runDense(A, B, C, (int)sweep->sizes[s], sweep->workers[t], forceGeneric,
+                              &sweep->cfg, csvFilename, sweep->samplesFile, &scaling, 0);
+        }
+    }
     printf("Datos guardados en: %s\n", csvFilename);
+    scalingFinish(&scaling, RESULTS_DIR);
+
+    BenchRecord memRecord = { "caso2", "openmp_opt", "openmp", maxSize, benchSweepMaxWorkers(sweep), 0.0 };
+    memTrackReport(RESULTS_DIR, &memRecord);
+
+    freeMatrix(A, maxSize);
+    freeMatrix(B, maxSize);
+    freeMatrix(C, maxSize);
+    free(csvFilename);
+    return status;
+}
+
+/* ==========================================
+ * Programa principal
+ * ========================================== */
+void printUsage(const char* prog) {
+    fprintf(stderr,
+        "Uso: %s <tamaño_matriz> <num_hilos> [save] [generic] [density=D] [densityB=D] [threshold=T]\n"
+        "       [mode=gemm|gemv|spmv|power|chain] [stream] [power=K] [dims=d0,d1,...,dm]\n"
+        "  mode=M       gemm (por defecto), gemv (y = A·x densa), spmv (CSR),\n"
+        "               power (A^K) o chain (A1·…·Am con Ai de d(i-1) x d(i))\n"
+        "  stream       prefetch no temporal de la matriz en gemv/spmv\n"
+        "  density=D    densidad de A y B en (0, 1] (activa el modo disperso)\n"
+        "  densityB=D   densidad de B si difiere de A\n"
+        "  threshold=T  densidad máxima para usar formato disperso (por defecto %.2f)\n"
+        "       %s --sweep sizes=a,b,... threads=a,b,... [reps=R] [warmup=W] [samples=archivo.csv] [generic]\n"
+        "  --sweep      todas las combinaciones tamaño x hilos (GEMM) en un solo proceso\n",
+        prog, SPARSE_THRESHOLD, prog);
+}
+
+int parseOptions(int argc, char* argv[], Options* opt) {
+    opt->mode = MODE_GEMM;
+    opt->size = atoi(argv[1]);
+    opt->threads = atoi(argv[2]);
+    opt->streaming = 0;
+    opt->power = 2;
+    opt->chain_len = 0;
+    opt->saveMatrices = 0;
+    opt->forceGeneric = 0;
+    opt->density_a = 1.0;
+    opt->density_b = -1.0;
+    opt->threshold = SPARSE_THRESHOLD;
+
+    for (int a = 3; a < argc; a++) {
+        if (strcmp(argv[a], "save") == 0) opt->saveMatrices = 1;
+        else if (strcmp(argv[a], "generic") == 0) opt->forceGeneric = 1;
+        else if (strcmp(argv[a], "stream") == 0) opt->streaming = 1;
+        else if (strcmp(argv[a], "mode=gemm") == 0) opt->mode = MODE_GEMM;
+        else if (strcmp(argv[a], "mode=gemv") == 0) opt->mode = MODE_GEMV;
+        else if (strcmp(argv[a], "mode=spmv") == 0) opt->mode = MODE_SPMV;
+        else if (strcmp(argv[a], "mode=power") == 0) opt->mode = MODE_POWER;
+        else if (strcmp(argv[a], "mode=chain") == 0) opt->mode = MODE_CHAIN;
+        else if (strncmp(argv[a], "power=", 6) == 0) opt->power = atoi(argv[a] + 6);
+        else if (strncmp(argv[a], "dims=", 5) == 0) {
+            int count = 0;
+            for (char* p = argv[a] + 5; *p; ) {
+                if (count > CHAIN_MAX_MATRICES) {
+                    fprintf(stderr, "Error: dims admite como máximo %d dimensiones (%d matrices).\n",
+                            CHAIN_MAX_MATRICES + 1, CHAIN_MAX_MATRICES);
+                    return 0;
+                }
+                opt->chain_dims[count++] = (int)strtol(p, &p, 10);
+                if (*p == ',') p++;
+                else if (*p != '\0') { count = 0; break; }
+            }
+            opt->chain_len = count - 1;
+        }
+        else if (strncmp(argv[a], "density=", 8) == 0) opt->density_a = atof(argv[a] + 8);
+        else if (strncmp(argv[a], "densityB=", 9) == 0) opt->density_b = atof(argv[a] + 9);
+        else if (strncmp(argv[a], "threshold=", 10) == 0) opt->threshold = atof(argv[a] + 10);
+        else {
+            fprintf(stderr, "Error: opción no reconocida: %s\n", argv[a]);
+            return 0;
+        }
+    }
+    /* SpMV sin densidad explícita: 1% de no nulos */
+    if (opt->mode == MODE_SPMV && opt->density_a >= 1.0) opt->density_a = 0.01;
+    if (opt->density_b < 0.0) opt->density_b = opt->density_a;
+
+    /* En mode=chain el tamaño lo dan las dimensiones */
+    if ((opt->size <= 0 && opt->mode != MODE_CHAIN) || opt->threads <= 0) {
+        fprintf(stderr, "Error: tamaño y número de hilos deben ser positivos.\n");
+        return 0;
+    }
+    if (opt->mode == MODE_POWER && opt->power < 1) {
+        fprintf(stderr, "Error: power debe ser >= 1.\n");
+        return 0;
+    }
+    if (opt->mode == MODE_CHAIN) {
+        if (opt->chain_len < 2) {
+            fprintf(stderr, "Error: dims necesita entre 3 y %d dimensiones.\n", CHAIN_MAX_MATRICES + 1);
+            return 0;
+        }
+        for (int i = 0; i <= opt->chain_len; i++) {
+            if (opt->chain_dims[i] <= 0) {
+                fprintf(stderr, "Error: las dimensiones de la cadena deben ser positivas.\n");
+                return 0;
+            }
+        }
+    }
+    if (opt->density_a <= 0.0 || opt->density_a > 1.0 ||
+        opt->density_b <= 0.0 || opt->density_b > 1.0) {
+        fprintf(stderr, "Error: la densidad debe estar en (0, 1].\n");
+        return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    if (benchIsSweep(argc, argv)) {
+        BenchConfig cfg;
+        benchConfigInit(&cfg);
+        BenchSweep sweep;
+        benchSweepInit(&sweep, &cfg);
+        int forceGeneric = 0;
+        for (int a = 2; a < argc; a++) {
+            if (benchSweepArg(&sweep, argv[a])) continue;
+            if (strcmp(argv[a], "generic") == 0) { forceGeneric = 1; continue; }
+            fprintf(stderr, "Error: opción no reconocida en --sweep: %s\n", argv[a]);
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        benchSweepCheck(&sweep, 1);
+
+        perfCountersOpen(&perfCounters);
+        srand(time(NULL));
+        return runSweep(&sweep, forceGeneric);
+    }
+
+    if (argc < 3) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
 
-    if (saveMatrices) {
-        printf("Guardando matrices en CSV...\n");
-        createDirectoryIfNotExists(DATA_DIR "/matrices");
-        saveMatrixCSV(DATA_DIR "/matrices", "A", A, size);
-        saveMatrixCSV(DATA_DIR "/matrices", "B", B, size);
-        saveMatrixCSV(DATA_DIR "/matrices", "C_resultado", C, size);
+    Options opt;
+    if (!parseOptions(argc, argv, &opt)) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
     }
+    int size = opt.size;
+    int threads = opt.threads;
+
+    perfCountersOpen(&perfCounters);
+    benchConfigInit(&benchConfig);
+    srand(time(NULL));
+
+    if (opt.mode == MODE_GEMV || opt.mode == MODE_SPMV)
+        return runMatVecBenchmark(&opt);
+    if (opt.mode == MODE_POWER || opt.mode == MODE_CHAIN)
+        return runChainBenchmark(&opt);
+
+    if (opt.density_a < 1.0 || opt.density_b < 1.0)
+        return runSparseBenchmark(&opt);
+
+    benchEnsureDir(DATA_DIR);
+    char* csvFilename = generateFilename(DATA_DIR);
+
+    printf("Creando matrices de %dx%d...\n", size, size);
+    memTrackPhase("generacion");
+    int** A = createMatrix(size);
+    int** B = createMatrix(size);
+    int** C = createResultMatrix(size);
+    printf("Matrices creadas. Iniciando multiplicación con %d hilos...\n", threads);
+
+    /* La verificación del kernel especializado (si hay) va dentro de runDense */
+    memTrackPhase("calculo");
+    ScalingStudy scaling;
+    scalingInit(&scaling);
+    int status = runDense(A, B, C, size, threads, opt.forceGeneric, &benchConfig,
+                          csvFilename, NULL, &scaling, 1);
+    scalingFinish(&scaling, RESULTS_DIR);
+
+    if (status == EXIT_SUCCESS && opt.saveMatrices) {
+        memTrackPhase("guardado");
+        saveMatricesCSV(A, B, C, size);
+    }
+    BenchRecord memRecord = { "caso2", "openmp_opt", "openmp", size, threads, 0.0 };
+    memTrackReport(RESULTS_DIR, &memRecord);
 
     freeMatrix(A, size);
     freeMatrix(B, size);
     freeMatrix(C, size);
     free(csvFilename);
 
-    return EXIT_SUCCESS;
+    return status;
 }
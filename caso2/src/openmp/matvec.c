@@ -0,0 +1,96 @@
+#include <omp.h>
+
+#include "matvec.h"
+
+/* Distancia de prefetch en elementos (~2 KB por delante) */
+#define PREFETCH_DIST 512
+/* Elementos por línea de caché de 64 bytes */
+#define LINE_INTS 16
+
+/* ==========================================
+ * GEMV denso: y = A·x
+ * ========================================== */
+void gemvOMP(int** A, const int* x, int* y, int size, int threads, int streaming) {
+    if (!streaming) {
+        #pragma omp parallel for schedule(static) num_threads(threads)
+        for (int i = 0; i < size; i++) {
+            const int* restrict a = A[i];
+            int sum = 0;
+            for (int j = 0; j < size; j++)
+                sum += a[j] * x[j];
+            y[i] = sum;
+        }
+        return;
+    }
+
+    #pragma omp parallel for schedule(static) num_threads(threads)
+    for (int i = 0; i < size; i++) {
+        const int* restrict a = A[i];
+        /* La fila siguiente vive en otro bloque: se adelanta su inicio */
+        if (i + 1 < size) __builtin_prefetch(A[i + 1], 0, 0);
+        int sum = 0;
+        int j = 0;
+        for (; j + LINE_INTS <= size; j += LINE_INTS) {
+            __builtin_prefetch(a + j + PREFETCH_DIST, 0, 0);
+            for (int jj = 0; jj < LINE_INTS; jj++)
+                sum += a[j + jj] * x[j + jj];
+        }
+        for (; j < size; j++)
+            sum += a[j] * x[j];
+        y[i] = sum;
+    }
+}
+
+/* ==========================================
+ * SpMV CSR: y = A·x
+ * ========================================== */
+void spmvOMP(const SparseMatrix* A, const int* x, int* y, int threads, int streaming) {
+    const long* restrict ptr = A->ptr;
+    const int* restrict idx = A->idx;
+    const int* restrict val = A->val;
+
+    if (!streaming) {
+        #pragma omp parallel for schedule(dynamic, 256) num_threads(threads)
+        for (int i = 0; i < A->n; i++) {
+            int sum = 0;
+            for (long p = ptr[i]; p < ptr[i + 1]; p++)
+                sum += val[p] * x[idx[p]];
+            y[i] = sum;
+        }
+        return;
+    }
+
+    /* Como en GEMV: una línea de idx y val por bloque, PREFETCH_DIST no nulos
+     * por delante. CSR es un solo flujo, así que pasa de largo a las filas
+     * siguientes */
+    #pragma omp parallel for schedule(dynamic, 256) num_threads(threads)
+    for (int i = 0; i < A->n; i++) {
+        const long end = ptr[i + 1];
+        int sum = 0;
+        long p = ptr[i];
+        for (; p + LINE_INTS <= end; p += LINE_INTS) {
+            __builtin_prefetch(idx + p + PREFETCH_DIST, 0, 0);
+            __builtin_prefetch(val + p + PREFETCH_DIST, 0, 0);
+            for (int q = 0; q < LINE_INTS; q++)
+                sum += val[p + q] * x[idx[p + q]];
+        }
+        for (; p < end; p++)
+            sum += val[p] * x[idx[p]];
+        y[i] = sum;
+    }
+}
+
+/* ==========================================
+ * Tráfico mínimo de memoria
+ * ========================================== */
+long long gemvBytes(int size) {
+    /* A completa + x + y */
+    return (long long)size * size * sizeof(int) + 2LL * size * sizeof(int);
+}
+
+long long spmvBytes(const SparseMatrix* A) {
+    /* idx + val + ptr + x + y (x contado una vez: cota inferior) */
+    return A->nnz * (long long)(sizeof(int) + sizeof(int))
+         + (A->n + 1LL) * sizeof(long)
+         + 2LL * A->n * sizeof(int);
+}
@@ -0,0 +1,20 @@
+#ifndef MATVEC_H
+#define MATVEC_H
+
+#include "sparse.h"
+
+/* ==========================================
+ * Producto matriz-vector (limitado por memoria)
+ * ==========================================
+ * Con `streaming` activo se emiten prefetch no temporales (prefetchnta)
+ * sobre la matriz, que se lee una sola vez, para no desalojar x de la
+ * caché. Conviene compararlo con la versión normal en cada máquina.
+ */
+void gemvOMP(int** A, const int* x, int* y, int size, int threads, int streaming);
+void spmvOMP(const SparseMatrix* A, const int* x, int* y, int threads, int streaming);
+
+/* Bytes mínimos que deben moverse desde memoria en cada kernel */
+long long gemvBytes(int size);
+long long spmvBytes(const SparseMatrix* A);
+
+#endif
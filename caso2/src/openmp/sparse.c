@@ -0,0 +1,333 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+
+#include "sparse.h"
+
+/* ==========================================
+ * Creación y liberación
+ * ========================================== */
+SparseMatrix* allocSparseMatrix(int size, long nnz) {
+    SparseMatrix* M = (SparseMatrix*)malloc(sizeof(SparseMatrix));
+    if (M == NULL) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para la matriz dispersa\n");
+        exit(EXIT_FAILURE);
+    }
+    M->n = size;
+    M->nnz = nnz;
+    M->ptr = (long*)calloc(size + 1, sizeof(long));
+    M->idx = (int*)malloc((nnz > 0 ? nnz : 1) * sizeof(int));
+    M->val = (int*)malloc((nnz > 0 ? nnz : 1) * sizeof(int));
+    if (M->ptr == NULL || M->idx == NULL || M->val == NULL) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para %ld no nulos\n", nnz);
+        exit(EXIT_FAILURE);
+    }
+    return M;
+}
+
+void freeSparseMatrix(SparseMatrix* M) {
+    if (M == NULL) return;
+    free(M->ptr);
+    free(M->idx);
+    free(M->val);
+    free(M);
+}
+
+SparseMatrix* createSparseMatrix(int size, double density) {
+    /* Reserva inicial según la densidad esperada; crece si hace falta */
+    long capacity = (long)((double)size * size * density * 1.1) + size + 1;
+    SparseMatrix* M = allocSparseMatrix(size, capacity);
+    long nnz = 0;
+
+    for (int i = 0; i < size; i++) {
+        M->ptr[i] = nnz;
+        for (int j = 0; j < size; j++) {
+            if ((double)rand() / RAND_MAX >= density) continue;
+            if (nnz == capacity) {
+                capacity *= 2;
+                M->idx = (int*)realloc(M->idx, capacity * sizeof(int));
+                M->val = (int*)realloc(M->val, capacity * sizeof(int));
+                if (M->idx == NULL || M->val == NULL) {
+                    fprintf(stderr, "Error: No se pudo ampliar la matriz dispersa\n");
+                    exit(EXIT_FAILURE);
+                }
+            }
+            M->idx[nnz] = j;
+            M->val[nnz] = rand() % 100 + 1;
+            nnz++;
+        }
+    }
+    M->ptr[size] = nnz;
+    M->nnz = nnz;
+    return M;
+}
+
+/* ==========================================
+ * Conversiones de formato
+ * ========================================== */
+SparseMatrix* csrToCsc(const SparseMatrix* A) {
+    int n = A->n;
+    SparseMatrix* T = allocSparseMatrix(n, A->nnz);
+
+    for (long p = 0; p < A->nnz; p++) T->ptr[A->idx[p] + 1]++;
+    for (int j = 0; j < n; j++) T->ptr[j + 1] += T->ptr[j];
+
+    long* next = (long*)malloc(n * sizeof(long));
+    if (next == NULL) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para la conversión CSC\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(next, T->ptr, n * sizeof(long));
+
+    /* Recorrer filas en orden deja cada columna con filas ascendentes */
+    for (int i = 0; i < n; i++) {
+        for (long p = A->ptr[i]; p < A->ptr[i + 1]; p++) {
+            long q = next[A->idx[p]]++;
+            T->idx[q] = i;
+            T->val[q] = A->val[p];
+        }
+    }
+
+    free(next);
+    return T;
+}
+
+void csrToDense(const SparseMatrix* A, int** D) {
+    for (int i = 0; i < A->n; i++) {
+        memset(D[i], 0, A->n * sizeof(int));
+        for (long p = A->ptr[i]; p < A->ptr[i + 1]; p++)
+            D[i][A->idx[p]] = A->val[p];
+    }
+}
+
+/* ==========================================
+ * SpGEMM de Gustavson (CSR x CSR -> CSR)
+ * ==========================================
+ * Dos pasadas: simbólica (no nulos por fila) y numérica. Cada hilo tiene
+ * su propio acumulador, de modo que no hay sincronización por fila:
+ *   - denso: arreglo de n valores con marcas por fila (filas con mucho
+ *     trabajo respecto a n)
+ *   - hash: tabla abierta de potencia de dos (filas con poco trabajo,
+ *     evita recorrer/limpiar n posiciones)
+ */
+#define HASH_EMPTY (-1)
+
+typedef struct {
+    int* dense_val;     // n valores
+    int* dense_mark;    // n marcas (fila que usó la posición por última vez)
+    int* hash_key;      // capacidad hash_cap
+    int* hash_val;
+    int hash_cap;
+    int* cols;          // columnas tocadas en la fila actual
+} RowAccumulator;
+
+typedef struct {
+    int col;
+    int val;
+} ColVal;
+
+static int compareColVal(const void* a, const void* b) {
+    const ColVal* x = (const ColVal*)a;
+    const ColVal* y = (const ColVal*)b;
+    return (x->col > y->col) - (x->col < y->col);
+}
+
+static int nextPow2(long x) {
+    int p = 1;
+    while (p < x) p <<= 1;
+    return p;
+}
+
+/* Cota superior de no nulos de la fila i de A·B */
+static long rowUpperBound(const SparseMatrix* A, const SparseMatrix* B, int i) {
+    long ub = 0;
+    for (long p = A->ptr[i]; p < A->ptr[i + 1]; p++) {
+        int k = A->idx[p];
+        ub += B->ptr[k + 1] - B->ptr[k];
+    }
+    return ub;
+}
+
+long long spgemmFlops(const SparseMatrix* A, const SparseMatrix* B) {
+    long long flops = 0;
+    for (int i = 0; i < A->n; i++) flops += rowUpperBound(A, B, i);
+    return flops;
+}
+
+/* Acumula la fila i de A·B. Devuelve sus no nulos; si `out` no es NULL
+ * escribe las parejas (columna, valor) ordenadas por columna. */
+static long accumulateRow(const SparseMatrix* A, const SparseMatrix* B, int i,
+                          RowAccumulator* acc, ColVal* out) {
+    long ub = rowUpperBound(A, B, i);
+    if (ub == 0) return 0;
+
+    long count = 0;
+    int useHash = (ub * 8 < B->n) && (ub * 2 <= acc->hash_cap);
+
+    if (useHash) {
+        int cap = nextPow2(ub * 2);
+        int mask = cap - 1;
+        for (int h = 0; h < cap; h++) acc->hash_key[h] = HASH_EMPTY;
+
+        for (long p = A->ptr[i]; p < A->ptr[i + 1]; p++) {
+            int k = A->idx[p];
+            int a = A->val[p];
+            for (long q = B->ptr[k]; q < B->ptr[k + 1]; q++) {
+                int j = B->idx[q];
+                int h = (int)(((unsigned)j * 2654435761u) & mask);
+                while (acc->hash_key[h] != HASH_EMPTY && acc->hash_key[h] != j)
+                    h = (h + 1) & mask;
+                if (acc->hash_key[h] == HASH_EMPTY) {
+                    acc->hash_key[h] = j;
+                    acc->hash_val[h] = 0;
+                    count++;
+                }
+                acc->hash_val[h] += a * B->val[q];
+            }
+        }
+
+        if (out != NULL) {
+            long c = 0;
+            for (int h = 0; h < cap; h++) {
+                if (acc->hash_key[h] == HASH_EMPTY) continue;
+                out[c].col = acc->hash_key[h];
+                out[c].val = acc->hash_val[h];
+                c++;
+            }
+        }
+    } else {
+        for (long p = A->ptr[i]; p < A->ptr[i + 1]; p++) {
+            int k = A->idx[p];
+            int a = A->val[p];
+            for (long q = B->ptr[k]; q < B->ptr[k + 1]; q++) {
+                int j = B->idx[q];
+                if (acc->dense_mark[j] != i) {
+                    acc->dense_mark[j] = i;
+                    acc->dense_val[j] = 0;
+                    acc->cols[count++] = j;
+                }
+                acc->dense_val[j] += a * B->val[q];
+            }
+        }
+
+        if (out != NULL) {
+            for (long c = 0; c < count; c++) {
+                out[c].col = acc->cols[c];
+                out[c].val = acc->dense_val[acc->cols[c]];
+            }
+        }
+    }
+
+    if (out != NULL) qsort(out, count, sizeof(ColVal), compareColVal);
+    return count;
+}
+
+SparseMatrix* spgemmOMP(const SparseMatrix* A, const SparseMatrix* B, int threads) {
+    int n = A->n;
+    long* rowNnz = (long*)calloc(n + 1, sizeof(long));
+    if (rowNnz == NULL) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para SpGEMM\n");
+        exit(EXIT_FAILURE);
+    }
+
+    long maxUb = 0;
+    for (int i = 0; i < n; i++) {
+        long ub = rowUpperBound(A, B, i);
+        if (ub > maxUb) maxUb = ub;
+    }
+    /* La tabla hash solo se usa cuando ub < n/8, así que basta con n/4 */
+    int hashCap = nextPow2(maxUb * 2 < n / 4 ? maxUb * 2 : n / 4);
+    if (hashCap < 1) hashCap = 1;
+
+    SparseMatrix* C = NULL;
+
+    #pragma omp parallel num_threads(threads)
+    {
+        RowAccumulator acc;
+        acc.dense_val = (int*)malloc(n * sizeof(int));
+        acc.dense_mark = (int*)malloc(n * sizeof(int));
+        acc.cols = (int*)malloc(n * sizeof(int));
+        acc.hash_key = (int*)malloc(hashCap * sizeof(int));
+        acc.hash_val = (int*)malloc(hashCap * sizeof(int));
+        acc.hash_cap = hashCap;
+        ColVal* rowBuf = (ColVal*)malloc(n * sizeof(ColVal));
+        if (!acc.dense_val || !acc.dense_mark || !acc.cols ||
+            !acc.hash_key || !acc.hash_val || !rowBuf) {
+            fprintf(stderr, "Error: No se pudo asignar el acumulador del hilo %d\n",
+                    omp_get_thread_num());
+            exit(EXIT_FAILURE);
+        }
+        for (int j = 0; j < n; j++) acc.dense_mark[j] = -1;
+
+        /* Pasada simbólica */
+        #pragma omp for schedule(dynamic, 64)
+        for (int i = 0; i < n; i++)
+            rowNnz[i + 1] = accumulateRow(A, B, i, &acc, NULL);
+
+        #pragma omp single
+        {
+            for (int i = 0; i < n; i++) rowNnz[i + 1] += rowNnz[i];
+            C = allocSparseMatrix(n, rowNnz[n]);
+            memcpy(C->ptr, rowNnz, (n + 1) * sizeof(long));
+        }
+
+        /* Pasada numérica: las marcas del denso deben reiniciarse */
+        for (int j = 0; j < n; j++) acc.dense_mark[j] = -1;
+
+        #pragma omp for schedule(dynamic, 64)
+        for (int i = 0; i < n; i++) {
+            long count = accumulateRow(A, B, i, &acc, rowBuf);
+            long base = C->ptr[i];
+            for (long c = 0; c < count; c++) {
+                C->idx[base + c] = rowBuf[c].col;
+                C->val[base + c] = rowBuf[c].val;
+            }
+        }
+
+        free(acc.dense_val);
+        free(acc.dense_mark);
+        free(acc.cols);
+        free(acc.hash_key);
+        free(acc.hash_val);
+        free(rowBuf);
+    }
+
+    free(rowNnz);
+    return C;
+}
+
+/* ==========================================
+ * SpMM: dispersa (CSR) x densa -> densa
+ * ========================================== */
+void spmmOMP(const SparseMatrix* A, int** B, int** C, int threads) {
+    int n = A->n;
+    #pragma omp parallel for schedule(dynamic, 16) num_threads(threads)
+    for (int i = 0; i < n; i++) {
+        int* restrict c = C[i];
+        for (long p = A->ptr[i]; p < A->ptr[i + 1]; p++) {
+            const int a = A->val[p];
+            const int* restrict b = B[A->idx[p]];
+            for (int j = 0; j < n; j++)
+                c[j] += a * b[j];
+        }
+    }
+}
+
+/* ==========================================
+ * Densa x dispersa (CSC) -> densa
+ * ========================================== */
+void denseTimesCscOMP(int** A, const SparseMatrix* Bcsc, int** C, int threads) {
+    int n = Bcsc->n;
+    #pragma omp parallel for schedule(static) num_threads(threads)
+    for (int i = 0; i < n; i++) {
+        const int* restrict a = A[i];
+        int* restrict c = C[i];
+        for (int j = 0; j < n; j++) {
+            int sum = 0;
+            for (long p = Bcsc->ptr[j]; p < Bcsc->ptr[j + 1]; p++)
+                sum += a[Bcsc->idx[p]] * Bcsc->val[p];
+            c[j] += sum;
+        }
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef SPARSE_H
+#define SPARSE_H
+
+/* ==========================================
+ * Matrices dispersas (CSR / CSC)
+ * ==========================================
+ * Misma estructura para ambos formatos:
+ *   CSR: ptr indexa filas,   idx guarda columnas
+ *   CSC: ptr indexa columnas, idx guarda filas
+ * Solo matrices cuadradas de tamaño n, como el resto del proyecto.
+ */
+typedef struct {
+    int n;          // Dimensión (n x n)
+    long nnz;       // Elementos no nulos
+    long* ptr;      // n + 1 desplazamientos
+    int* idx;       // nnz índices (columna en CSR, fila en CSC)
+    int* val;       // nnz valores
+} SparseMatrix;
+
+/* Genera una matriz CSR aleatoria: cada elemento es no nulo con
+ * probabilidad `density` y toma valores en [1, 100] como createMatrix. */
+SparseMatrix* createSparseMatrix(int size, double density);
+
+SparseMatrix* allocSparseMatrix(int size, long nnz);
+void freeSparseMatrix(SparseMatrix* M);
+
+/* Conversiones de formato */
+SparseMatrix* csrToCsc(const SparseMatrix* A);
+void csrToDense(const SparseMatrix* A, int** D);
+
+/* Multiplicaciones */
+SparseMatrix* spgemmOMP(const SparseMatrix* A, const SparseMatrix* B, int threads);
+void spmmOMP(const SparseMatrix* A, int** B, int** C, int threads);
+void denseTimesCscOMP(int** A, const SparseMatrix* Bcsc, int** C, int threads);
+
+/* Multiplicaciones-suma efectivas de A·B (para GOPS) */
+long long spgemmFlops(const SparseMatrix* A, const SparseMatrix* B);
+
+#endif
@@ -2,8 +2,13 @@
 #include <stdlib.h>
 #include <sys/stat.h>
 #include <time.h>
+#include <string.h>
 #include <mpi.h>
 
+#include "hpcbench.h"
+#include "scaling.h"
+#include "memTrack.h"
+
 /* ======================================================
  * FUNCIONES AUXILIARES DE MATRICES
  * ====================================================== */
@@ -30,6 +35,14 @@ void freeMatrix(int** mat, int n) {
     free(mat);
 }
 
+/* En modo adaptativo (BENCH_TARGET_CI) cada rango vería un IC distinto y
+ * cortaría en otra repetición: manda la decisión de rank 0 */
+static int runNextAllRanks(BenchRun* run) {
+    int more = benchRunNext(run);
+    MPI_Bcast(&more, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    return more;
+}
+
 /* ======================================================
  * PROGRAMA PRINCIPAL MPI
  * ====================================================== */
@@ -53,6 +66,8 @@ int main(int argc, char* argv[]) {
     int start_row = rank * rows_per_proc + (rank < remainder ? rank : remainder);
     int local_rows = rows_per_proc + (rank < remainder ? 1 : 0);
 
+    /* Fases de memoria de rank 0, que genera, aplana y recolecta todo */
+    memTrackPhase("buffers");
     int* local_A = malloc(local_rows * n * sizeof(int));
     int* B = malloc(n * n * sizeof(int));
     int* local_C = calloc(local_rows * n, sizeof(int));
@@ -61,9 +76,11 @@ int main(int argc, char* argv[]) {
 
     if (rank == 0) {
         srand(time(NULL));
+        memTrackPhase("generacion");
         int** A = createMatrix(n);
         int** B_mat = createMatrix(n);
 
+        memTrackPhase("aplanado");
         A_flat = flattenMatrix(A, n);
         for (int i = 0; i < n; i++)
             for (int j = 0; j < n; j++)
@@ -71,6 +88,7 @@ int main(int argc, char* argv[]) {
 
         freeMatrix(A, n);
         freeMatrix(B_mat, n);
+        memTrackPhase("distribucion");
     }
 
     int* sendcounts = malloc(size * sizeof(int));
@@ -86,17 +104,46 @@ int main(int argc, char* argv[]) {
 
     MPI_Bcast(B, n*n, MPI_INT, 0, MPI_COMM_WORLD);
 
-    MPI_Barrier(MPI_COMM_WORLD);
-    double start_time = MPI_Wtime();
-
-    for (int i = 0; i < local_rows; i++)
-        for (int k = 0; k < n; k++)
-            for (int j = 0; j < n; j++)
-                local_C[i*n + j] += local_A[i*n + k] * B[k*n + j];
+    /* Todos los rangos deben hacer las mismas corridas: manda la de rank 0 */
+    BenchConfig benchConfig;
+    if (rank == 0) benchConfigInit(&benchConfig);
+    MPI_Bcast(&benchConfig, sizeof(benchConfig), MPI_BYTE, 0, MPI_COMM_WORLD);
+
+    memTrackPhase("calculo");
+    /* Un solo worker por rango: esta parte y la espera en la barrera final */
+    WorkerTimes times;
+    workerTimesInit(&times, 1, 0);
+
+    BenchRun run;
+    benchRunInit(&run, &benchConfig);
+    while (runNextAllRanks(&run)) {
+        /* local_C acumula: se limpia fuera de la región medida */
+        memset(local_C, 0, local_rows * n * sizeof(int));
+
+        MPI_Barrier(MPI_COMM_WORLD);
+        benchStart(&run);
+        times.start[0] = benchNow();
+
+        for (int i = 0; i < local_rows; i++)
+            for (int k = 0; k < n; k++)
+                for (int j = 0; j < n; j++)
+                    local_C[i*n + j] += local_A[i*n + k] * B[k*n + j];
+        times.end[0] = benchNow();
+
+        MPI_Barrier(MPI_COMM_WORLD);
+        benchStop(&run);
+        workerTimesJoin(&times, &run);
+    }
+    benchRunFinish(&run);
 
-    MPI_Barrier(MPI_COMM_WORLD);
-    double end_time = MPI_Wtime();
+    /* Rank 0 junta el tiempo ocupado y la espera en la barrera de cada rango */
+    WorkerTimes ranks;
+    if (rank == 0) workerTimesInit(&ranks, size, 0);
+    MPI_Gather(times.busy, 1, MPI_DOUBLE, rank == 0 ? ranks.busy : NULL, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    MPI_Gather(times.idle, 1, MPI_DOUBLE, rank == 0 ? ranks.idle : NULL, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    workerTimesFree(&times);
 
+    memTrackPhase("recoleccion");
     if (rank == 0) C_flat = malloc(n * n * sizeof(int));
 
     MPI_Gatherv(local_C, local_rows*n, MPI_INT,
@@ -104,13 +151,11 @@ int main(int argc, char* argv[]) {
                 0, MPI_COMM_WORLD);
 
     if (rank == 0) {
-        double elapsed = end_time - start_time;
+        double elapsed = run.summary.median;
         printf("\nTamaño: %d x %d\nTiempo MPI: %.6f s\n", n, n, elapsed);
+        benchPrintSummary(&run);
 
-        int ret = system("mkdir -p results");
-        if (ret != 0) {
-            fprintf(stderr, "No se pudo crear la carpeta results\n");
-        }
+        benchEnsureDir("results");
 
         // Guardar en CSV
         char filename[64];
@@ -131,9 +176,21 @@ int main(int argc, char* argv[]) {
             fprintf(stderr, "Error al crear el archivo CSV\n");
         }
 
+        BenchRecord record = {"caso3", "mul_mat", "mpi", n, size, 2.0 * n * n * (double)n};
+        benchWriteUnified("results", &record, &run);
+
+        ranks.reps = run.summary.n;
+        ScalingStudy scaling;
+        scalingInit(&scaling);
+        scalingAdd(&scaling, &record, &run, &ranks);
+        scalingFinish(&scaling, "results");
+        workerTimesFree(&ranks);
+        memTrackReport("results", &record);
+
         free(C_flat);
         free(A_flat);
     }
+    benchRunFree(&run);
 
     free(local_A);
     free(local_C);
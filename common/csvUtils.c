@@ -0,0 +1,73 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "csvUtils.h"
+
+static void writeNewCSV(const char* filename, const char* header) {
+    FILE* f = fopen(filename, "w");
+    if (f == NULL) {
+        fprintf(stderr, "Error: No se pudo crear el archivo CSV %s\n", filename);
+        exit(EXIT_FAILURE);
+    }
+    fprintf(f, "%s\n", header);
+    fclose(f);
+}
+
+void ensureCSVHeader(const char* filename, const char* header) {
+    FILE* f = fopen(filename, "r");
+    if (f == NULL) {
+        writeNewCSV(filename, header);
+        return;
+    }
+
+    char current[4096];
+    if (fgets(current, sizeof(current), f) == NULL) {
+        fclose(f);
+        writeNewCSV(filename, header);
+        return;
+    }
+    current[strcspn(current, "\r\n")] = '\0';
+
+    if (strcmp(current, header) == 0) {
+        fclose(f);
+        return;
+    }
+
+    size_t len = strlen(current);
+    if (strncmp(header, current, len) != 0 || header[len] != ',') {
+        fclose(f);
+        char old[1024];
+        snprintf(old, sizeof(old), "%s.old", filename);
+        if (rename(filename, old) != 0) {
+            fprintf(stderr, "Error: No se pudo renombrar %s\n", filename);
+            exit(EXIT_FAILURE);
+        }
+        fprintf(stderr, "Aviso: cabecera incompatible, datos anteriores en %s\n", old);
+        writeNewCSV(filename, header);
+        return;
+    }
+
+    /* Mismas columnas más otras al final: se reescribe la cabecera */
+    char tmp[1024];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", filename);
+    FILE* out = fopen(tmp, "w");
+    if (out == NULL) {
+        fclose(f);
+        fprintf(stderr, "Error: No se pudo crear %s\n", tmp);
+        exit(EXIT_FAILURE);
+    }
+    fprintf(out, "%s\n", header);
+
+    char buf[8192];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        fwrite(buf, 1, n, out);
+
+    fclose(f);
+    fclose(out);
+    if (rename(tmp, filename) != 0) {
+        fprintf(stderr, "Error: No se pudo actualizar %s\n", filename);
+        exit(EXIT_FAILURE);
+    }
+}
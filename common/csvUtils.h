@@ -0,0 +1,15 @@
+#ifndef CSV_UTILS_H
+#define CSV_UTILS_H
+
+/* ==========================================
+ * Cabeceras CSV con columnas nuevas
+ * ==========================================
+ * Crea el archivo con `header` si no existe. Si existe con una cabecera
+ * que es prefijo de `header` (se agregaron columnas al final), reescribe
+ * solo la primera línea: las filas viejas quedan con campos de menos y
+ * pandas las lee con NaN. Si la cabecera es incompatible, el archivo
+ * viejo se renombra a <archivo>.old y se empieza uno nuevo.
+ */
+void ensureCSVHeader(const char* filename, const char* header);
+
+#endif
@@ -0,0 +1,609 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+#include "hpcbench.h"
+#include "csvUtils.h"
+#include "machineInfo.h"
+#include "memTrack.h"
+#include "trace.h"
+
+#define BENCH_DEFAULT_WARMUP 1
+#define BENCH_DEFAULT_REPS 5
+#define BENCH_ADAPTIVE_REPS 50      // tope por defecto en modo adaptativo
+#define BENCH_DRIFT_WARN 1.10       // deriva a partir de la cual se avisa
+
+/* ==========================================
+ * Utilidades
+ * ========================================== */
+double benchNow(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+double benchTimevalToSeconds(struct timeval tv) {
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/* mkdir -p */
+void benchEnsureDir(const char* path) {
+    if (path == NULL || *path == '\0') return;
+    char tmp[512];
+    snprintf(tmp, sizeof(tmp), "%s", path);
+    for (char* p = tmp + 1; *p; p++) {
+        if (*p != '/') continue;
+        *p = '\0';
+        mkdir(tmp, 0755);
+        *p = '/';
+    }
+    if (mkdir(tmp, 0755) == -1 && errno != EEXIST) {
+        fprintf(stderr, "Error creando directorio %s: %s\n", tmp, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+}
+
+static int envInt(const char* name, int fallback, int minimum) {
+    const char* v = getenv(name);
+    if (v == NULL || *v == '\0') return fallback;
+    int x = atoi(v);
+    if (x < minimum) {
+        fprintf(stderr, "Error: %s=%s inválido (mínimo %d)\n", name, v, minimum);
+        exit(EXIT_FAILURE);
+    }
+    return x;
+}
+
+/* Fracción en (0, 1), p. ej. 0.02 para ±2% */
+static double parseFraction(const char* name, const char* v) {
+    char* end;
+    double x = strtod(v, &end);
+    if (end == v || *end != '\0' || x <= 0.0 || x >= 1.0) {
+        fprintf(stderr, "Error: %s=%s inválido (debe estar entre 0 y 1)\n", name, v);
+        exit(EXIT_FAILURE);
+    }
+    return x;
+}
+
+void benchConfigInit(BenchConfig* cfg) {
+    cfg->warmup = envInt("BENCH_WARMUP", BENCH_DEFAULT_WARMUP, 0);
+    cfg->reps = envInt("BENCH_REPS", BENCH_REPS_UNSET, 1);
+    cfg->noAlloc = envInt("BENCH_NO_ALLOC", 0, 0);
+    cfg->minReps = envInt("BENCH_MIN_REPS", 5, 2);
+    const char* ci = getenv("BENCH_TARGET_CI");
+    cfg->targetCI = (ci != NULL && *ci != '\0') ? parseFraction("BENCH_TARGET_CI", ci) : 0.0;
+}
+
+int benchConfigReps(const BenchConfig* cfg) {
+    if (cfg->reps != BENCH_REPS_UNSET) return cfg->reps;
+    return cfg->targetCI > 0.0 ? BENCH_ADAPTIVE_REPS : BENCH_DEFAULT_REPS;
+}
+
+/* Suma de los contadores de thermal throttling de todas las CPUs, o -1 si
+ * el kernel no los expone (máquinas virtuales, CPUs que no son Intel) */
+static long readThrottleCount(void) {
+    static const char* files[] = { "core_throttle_count", "package_throttle_count" };
+    long total = -1;
+    for (int cpu = 0; cpu < 4096; cpu++) {
+        char path[128];
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d", cpu);
+        struct stat st;
+        if (stat(path, &st) != 0) break;
+        for (int i = 0; i < 2; i++) {
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/thermal_throttle/%s", cpu, files[i]);
+            FILE* f = fopen(path, "r");
+            if (f == NULL) continue;
+            long v;
+            if (fscanf(f, "%ld", &v) == 1) total = (total < 0 ? 0 : total) + v;
+            fclose(f);
+        }
+    }
+    return total;
+}
+
+/* ==========================================
+ * Corridas
+ * ========================================== */
+void benchRunInit(BenchRun* run, const BenchConfig* cfg) {
+    memset(run, 0, sizeof(*run));
+    run->cfg = *cfg;
+    run->iter = -1;
+    /* Modo adaptativo: reps es el tope */
+    run->cfg.reps = benchConfigReps(cfg);
+    if (run->cfg.targetCI > 0.0 && run->cfg.minReps > run->cfg.reps)
+        run->cfg.minReps = run->cfg.reps;
+    run->samples = (double*)malloc(run->cfg.reps * sizeof(double));
+    run->sorted = (double*)malloc(run->cfg.reps * sizeof(double));
+    if (run->samples == NULL || run->sorted == NULL) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para %d repeticiones\n", run->cfg.reps);
+        exit(EXIT_FAILURE);
+    }
+    run->throttle0 = readThrottleCount();
+}
+
+int benchRunNext(BenchRun* run) {
+    run->iter++;
+    if (run->iter < run->cfg.warmup) return 1;
+    if (run->count >= run->cfg.reps) return 0;
+    if (run->cfg.targetCI > 0.0 && run->count >= run->cfg.minReps &&
+        benchMedianRelCI(run->sorted, run->count) <= run->cfg.targetCI) return 0;
+    return 1;
+}
+
+int benchIsWarmup(const BenchRun* run) {
+    return run->iter < run->cfg.warmup;
+}
+
+void benchStart(BenchRun* run) {
+    getrusage(RUSAGE_SELF, &run->ru0);
+    getrusage(RUSAGE_CHILDREN, &run->ruc0);
+    TRACE_BEGIN_ARG(benchIsWarmup(run) ? "calentamiento" : "repeticion", run->iter);
+    run->allocs0 = memTrackAllocCount();
+    run->t0 = benchNow();
+}
+
+void benchStop(BenchRun* run) {
+    double t1 = benchNow();
+    run->t1 = t1;
+    long allocs = memTrackAllocCount() - run->allocs0;
+    TRACE_END(benchIsWarmup(run) ? "calentamiento" : "repeticion");
+    struct rusage ru1, ruc1;
+    getrusage(RUSAGE_SELF, &ru1);
+    getrusage(RUSAGE_CHILDREN, &ruc1);
+    if (benchIsWarmup(run) || run->count >= run->cfg.reps) return;
+
+    if (allocs > 0 && run->cfg.noAlloc) {
+        fprintf(stderr, "Error: %ld asignaciones de memoria dentro de la región medida (BENCH_NO_ALLOC=1)\n",
+                allocs);
+        exit(EXIT_FAILURE);
+    }
+    run->timed_allocs += allocs;
+
+    /* Inserción ordenada: benchRunNext consulta el IC de la mediana */
+    double t = t1 - run->t0;
+    int pos = run->count;
+    while (pos > 0 && run->sorted[pos - 1] > t) {
+        run->sorted[pos] = run->sorted[pos - 1];
+        pos--;
+    }
+    run->sorted[pos] = t;
+    run->samples[run->count++] = t;
+    run->user_time += benchTimevalToSeconds(ru1.ru_utime) - benchTimevalToSeconds(run->ru0.ru_utime)
+                    + benchTimevalToSeconds(ruc1.ru_utime) - benchTimevalToSeconds(run->ruc0.ru_utime);
+    run->system_time += benchTimevalToSeconds(ru1.ru_stime) - benchTimevalToSeconds(run->ru0.ru_stime)
+                      + benchTimevalToSeconds(ruc1.ru_stime) - benchTimevalToSeconds(run->ruc0.ru_stime);
+    if (ru1.ru_maxrss > run->max_rss_kb) run->max_rss_kb = ru1.ru_maxrss;
+    if (ruc1.ru_maxrss > run->max_rss_kb) run->max_rss_kb = ruc1.ru_maxrss;
+}
+
+void benchRunFinish(BenchRun* run) {
+    benchSummarize(run->samples, run->count, &run->summary);
+    if (run->count > 0) {
+        run->user_time /= run->count;
+        run->system_time /= run->count;
+    }
+    long throttle1 = readThrottleCount();
+    run->throttleEvents = (run->throttle0 >= 0 && throttle1 >= 0) ? throttle1 - run->throttle0 : -1;
+}
+
+void benchCpuTimeUnknown(BenchRun* run) {
+    run->user_time = -1.0;
+    run->system_time = -1.0;
+}
+
+void benchRunFree(BenchRun* run) {
+    free(run->samples);
+    free(run->sorted);
+    run->samples = NULL;
+    run->sorted = NULL;
+}
+
+/* ==========================================
+ * Estadísticos
+ * ========================================== */
+static int compareDouble(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/* t de Student de dos colas al 95% para n - 1 grados de libertad */
+static double studentT95(int dof) {
+    static const double table[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (dof < 1) return 0.0;
+    if (dof <= 30) return table[dof - 1];
+    return 1.96;
+}
+
+/* Rangos (base 0) del IC del 95% de la mediana por estadísticos de orden:
+ * n/2 ± 1.96·sqrt(n)/2 (aproximación normal de la binomial). Con n < 6
+ * el intervalo es [mín, máx]. */
+static void medianCIRanks(int n, int* lo, int* hi) {
+    double half = 1.96 * sqrt((double)n) / 2.0;
+    *lo = (int)floor(n / 2.0 - half) - 1;
+    *hi = (int)ceil(n / 2.0 + half);
+    if (*lo < 0) *lo = 0;
+    if (*hi > n - 1) *hi = n - 1;
+}
+
+static double sortedMedian(const double* sorted, int n) {
+    return (n % 2) ? sorted[n / 2] : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+}
+
+double benchMedianRelCI(const double* sorted, int n) {
+    if (n <= 0) return 0.0;
+    double median = sortedMedian(sorted, n);
+    if (median <= 0.0) return 0.0;
+    int lo, hi;
+    medianCIRanks(n, &lo, &hi);
+    return 0.5 * (sorted[hi] - sorted[lo]) / median;
+}
+
+/* Cuantil con interpolación lineal entre vecinos */
+static double sortedQuantile(const double* sorted, int n, double p) {
+    double pos = p * (n - 1);
+    int i = (int)pos;
+    if (i >= n - 1) return sorted[n - 1];
+    return sorted[i] + (pos - i) * (sorted[i + 1] - sorted[i]);
+}
+
+/* Mediana de un tramo sin ordenar (se copia y se ordena) */
+static double sliceMedian(const double* samples, int n, double* scratch) {
+    memcpy(scratch, samples, n * sizeof(double));
+    qsort(scratch, n, sizeof(double), compareDouble);
+    return sortedMedian(scratch, n);
+}
+
+void benchSummarize(const double* samples, int n, BenchSummary* out) {
+    memset(out, 0, sizeof(*out));
+    out->n = n;
+    if (n <= 0) return;
+
+    double* sorted = (double*)malloc(n * sizeof(double));
+    if (sorted == NULL) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para los estadísticos\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(sorted, samples, n * sizeof(double));
+    qsort(sorted, n, sizeof(double), compareDouble);
+
+    out->min = sorted[0];
+    out->median = sortedMedian(sorted, n);
+    int lo, hi;
+    medianCIRanks(n, &lo, &hi);
+    out->medianLo = sorted[lo];
+    out->medianHi = sorted[hi];
+
+    double q1 = sortedQuantile(sorted, n, 0.25);
+    double q3 = sortedQuantile(sorted, n, 0.75);
+    double iqr = q3 - q1;
+    for (int i = 0; i < n; i++)
+        if (sorted[i] < q1 - 1.5 * iqr || sorted[i] > q3 + 1.5 * iqr) out->outliers++;
+
+    double sum = 0.0;
+    for (int i = 0; i < n; i++) sum += sorted[i];
+    out->mean = sum / n;
+
+    if (n > 1) {
+        double sq = 0.0;
+        for (int i = 0; i < n; i++) sq += (sorted[i] - out->mean) * (sorted[i] - out->mean);
+        out->stddev = sqrt(sq / (n - 1));
+        out->ci95 = studentT95(n - 1) * out->stddev / sqrt((double)n);
+    }
+
+    /* Deriva: compara el primer y el último tercio en orden de ejecución
+     * (reutiliza sorted como espacio de trabajo) */
+    out->drift = 1.0;
+    if (n >= 6) {
+        int third = n / 3;
+        double first = sliceMedian(samples, third, sorted);
+        double last = sliceMedian(samples + n - third, third, sorted);
+        if (first > 0.0) out->drift = last / first;
+    }
+    free(sorted);
+}
+
+void benchPrintSummary(const BenchRun* run) {
+    const BenchSummary* s = &run->summary;
+    printf("Repeticiones: %d (+%d de calentamiento)\n", s->n, run->cfg.warmup);
+    if (s->n > 1) {
+        printf("Tiempo (s): mín %.9f | mediana %.9f | media %.9f ± %.9f (IC 95%%) | desv %.9f\n",
+               s->min, s->median, s->mean, s->ci95, s->stddev);
+        double rel = s->median > 0.0 ? 0.5 * (s->medianHi - s->medianLo) / s->median : 0.0;
+        printf("Mediana: IC 95%% [%.9f, %.9f] (±%.2f%%)", s->medianLo, s->medianHi, 100.0 * rel);
+        if (run->cfg.targetCI > 0.0)
+            printf(" | objetivo ±%.2f%%%s", 100.0 * run->cfg.targetCI,
+                   rel <= run->cfg.targetCI ? "" : " no alcanzado (tope de repeticiones)");
+        printf("\n");
+        if (s->outliers > 0)
+            printf("Atípicos: %d de %d repeticiones (fuera de 1.5 IQR)\n", s->outliers, s->n);
+        if (s->drift > BENCH_DRIFT_WARN)
+            printf("Aviso: el último tercio fue %.2fx más lento que el primero (¿la CPU bajó la frecuencia?)\n",
+                   s->drift);
+    }
+    if (run->throttleEvents > 0)
+        printf("Aviso: %ld eventos de thermal throttling durante la corrida\n", run->throttleEvents);
+    if (run->timed_allocs > 0)
+        printf("Asignaciones de memoria en la región medida: %ld (%.1f por repetición)\n",
+               run->timed_allocs, (double)run->timed_allocs / (s->n > 0 ? s->n : 1));
+}
+
+/* ==========================================
+ * Esquema unificado
+ * ========================================== */
+void benchWriteUnified(const char* dirPath, const BenchRecord* rec, const BenchRun* run) {
+    benchEnsureDir(dirPath);
+    char filename[512];
+    snprintf(filename, sizeof(filename), "%s/Bench_Results.csv", dirPath);
+    ensureCSVHeader(filename, BENCH_CSV_HEADER);
+
+    FILE* f = fopen(filename, "a");
+    if (f == NULL) {
+        fprintf(stderr, "Error: no se pudo abrir %s\n", filename);
+        return;
+    }
+    const BenchSummary* s = &run->summary;
+    double gops = benchGops(rec, run);
+    const MachineInfo* mi = machineInfoGet();
+    fprintf(f, "%s,%s,%s,%ld,%d,%d,%d,%.9f,%.9f,%.9f,%.9f,%.9f,",
+            rec->project, rec->program, rec->variant ? rec->variant : rec->program,
+            rec->size, rec->workers, run->cfg.warmup, s->n,
+            s->min, s->median, s->mean, s->stddev, s->ci95);
+    /* Vacíos si no se pudo medir el CPU de los workers (benchCpuTimeUnknown) */
+    if (run->user_time >= 0) fprintf(f, "%.9f", run->user_time);
+    fputc(',', f);
+    if (run->system_time >= 0) fprintf(f, "%.9f", run->system_time);
+    fprintf(f, ",%.3f,%.0f,%.6f,%s,%s,%ld,"
+               "%.9f,%.9f,%d,%.4f,",
+            run->max_rss_kb / 1024.0,
+            rec->ops, gops, mi->machine_id, mi->build_id, run->timed_allocs,
+            s->medianLo, s->medianHi, s->outliers, s->drift);
+    /* Vacío si el kernel no expone los contadores de throttling */
+    if (run->throttleEvents >= 0) fprintf(f, "%ld", run->throttleEvents);
+    fprintf(f, "\n");
+    fclose(f);
+    machineInfoWrite(dirPath);
+
+    /* BENCH_SAMPLES=archivo: además cada repetición (lo usa make perfcheck) */
+    const char* samples = getenv("BENCH_SAMPLES");
+    if (samples != NULL && samples[0] != '\0') benchWriteSamples(samples, rec, run);
+}
+
+/* ==========================================
+ * Métricas derivadas y CSV históricos
+ * ========================================== */
+static double perMedianSecond(double amount, const BenchRun* run) {
+    return (amount > 0.0 && run->summary.median > 1e-9) ? amount / run->summary.median : 0.0;
+}
+
+double benchGops(const BenchRecord* rec, const BenchRun* run) {
+    return perMedianSecond(rec->ops, run) / 1e9;
+}
+
+double benchBandwidthGBs(const BenchRecord* rec, const BenchRun* run) {
+    return perMedianSecond(rec->bytes, run) / 1e9;
+}
+
+void benchPrintRecord(const BenchRecord* rec, const BenchRun* run) {
+    printf("Tiempo real: %.9f s\n", run->summary.median);
+    if (run->user_time >= 0 && run->system_time >= 0) {
+        printf("Tiempo usuario: %.9f s\n", run->user_time);
+        printf("Tiempo sistema: %.9f s\n", run->system_time);
+        printf("Tiempo total CPU: %.9f s\n", run->user_time + run->system_time);
+    } else {
+        printf("Tiempo de CPU: n/d\n");
+    }
+    if (rec->ops > 0) {
+        printf("Total operaciones: %.0f\n", rec->ops);
+        printf("Rendimiento: %.6f GOPS\n", benchGops(rec, run));
+    }
+    if (rec->bytes > 0)
+        printf("Ancho de banda: %.6f GB/s (%.0f bytes)\n", benchBandwidthGBs(rec, run), rec->bytes);
+    if (rec->elements > 0)
+        printf("Elementos/s: %.6f millones\n", perMedianSecond(rec->elements, run) / 1e6);
+    printf("Memoria usada: %ld MB\n", run->max_rss_kb / 1024);
+    benchPrintSummary(run);
+}
+
+/* Escribe el valor de la columna `name` (sin la coma); 0 si no es conocida */
+static int legacyColumn(FILE* f, const char* name, size_t len,
+                        const BenchRecord* rec, const BenchRun* run) {
+#define IS(col) (len == sizeof(col) - 1 && strncmp(name, col, len) == 0)
+    const double cpu = (run->user_time >= 0 && run->system_time >= 0)
+                     ? run->user_time + run->system_time : -1.0;
+    double seconds = -2.0;      // -2: no es un tiempo
+    if (IS("size") || IS("matrix_size") || IS("N") || IS("tamañoMatriz"))
+        fprintf(f, "%ld", rec->size);
+    else if (IS("threads") || IS("num_threads") || IS("num_procesos") || IS("#procesos"))
+        fprintf(f, "%d", rec->workers);
+    else if (IS("real_time") || IS("real_time_sec")) seconds = run->summary.median;
+    else if (IS("user_time") || IS("user_time_sec")) seconds = run->user_time;
+    else if (IS("system_time") || IS("system_time_sec")) seconds = run->system_time;
+    else if (IS("total_cpu_time") || IS("total_cpu_time_sec")) seconds = cpu;
+    else if (IS("total_operations")) fprintf(f, "%.0f", rec->ops);
+    else if (IS("gops") || IS("performance_gops")) fprintf(f, "%.6f", benchGops(rec, run));
+    else if (IS("bandwidth_gbs")) fprintf(f, "%.6f", benchBandwidthGBs(rec, run));
+    else if (IS("bytes_moved")) fprintf(f, "%.0f", rec->bytes);
+    else if (IS("elements_per_second_millions") || IS("elements_per_second_million"))
+        fprintf(f, "%.6f", perMedianSecond(rec->elements, run) / 1e6);
+    else if (IS("memory_used_mb")) fprintf(f, "%ld", run->max_rss_kb / 1024);
+    else return 0;
+#undef IS
+    /* CPU desconocido (pool de procesos): campo vacío */
+    if (seconds >= 0) fprintf(f, "%.9f", seconds);
+    return 1;
+}
+
+FILE* benchLegacyRow(const char* filename, const char* columns,
+                     const BenchRecord* rec, const BenchRun* run) {
+    ensureCSVHeader(filename, columns);
+    FILE* f = fopen(filename, "a");
+    if (f == NULL) {
+        fprintf(stderr, "Error: no se pudo abrir %s\n", filename);
+        return NULL;
+    }
+    for (const char* c = columns; *c != '\0'; ) {
+        const char* comma = strchr(c, ',');
+        size_t len = comma != NULL ? (size_t)(comma - c) : strlen(c);
+        if (!legacyColumn(f, c, len, rec, run)) break;
+        if (comma == NULL) break;
+        fputc(',', f);
+        c = comma + 1;
+    }
+    return f;
+}
+
+void benchLegacyEnd(FILE* f) {
+    if (f == NULL) return;
+    fputc('\n', f);
+    fclose(f);
+}
+
+void benchWriteSamples(const char* filename, const BenchRecord* rec, const BenchRun* run) {
+    if (filename == NULL) return;
+    ensureCSVHeader(filename, "project,program,variant,size,workers,rep,time_s,machine_id");
+
+    FILE* f = fopen(filename, "a");
+    if (f == NULL) {
+        fprintf(stderr, "Error: no se pudo abrir %s\n", filename);
+        return;
+    }
+    for (int i = 0; i < run->count; i++) {
+        fprintf(f, "%s,%s,%s,%ld,%d,%d,%.9f,%s\n",
+                rec->project, rec->program, rec->variant ? rec->variant : rec->program,
+                rec->size, rec->workers, i + 1, run->samples[i], machineInfoGet()->machine_id);
+    }
+    fclose(f);
+}
+
+/* ==========================================
+ * Barrido (--sweep)
+ * ========================================== */
+int benchIsSweep(int argc, char* argv[]) {
+    return argc > 1 && strcmp(argv[1], "--sweep") == 0;
+}
+
+void benchSweepInit(BenchSweep* sw, const BenchConfig* cfg) {
+    memset(sw, 0, sizeof(*sw));
+    sw->cfg = *cfg;
+    sw->nworkers = 1;
+    sw->workers[0] = 1;
+}
+
+/* Lista "a,b,c" de enteros positivos; devuelve cuántos leyó o -1 */
+static int parseList(const char* list, long* out) {
+    int n = 0;
+    const char* p = list;
+    while (*p) {
+        if (n == BENCH_SWEEP_MAX) return -1;
+        char* end;
+        long v = strtol(p, &end, 10);
+        if (end == p || v <= 0) return -1;
+        out[n++] = v;
+        if (*end == ',') end++;
+        else if (*end != '\0') return -1;
+        p = end;
+    }
+    return n;
+}
+
+int benchSweepArg(BenchSweep* sw, const char* arg) {
+    long tmp[BENCH_SWEEP_MAX];
+    const char* value;
+    if (strncmp(arg, "sizes=", 6) == 0) {
+        sw->nsizes = parseList(arg + 6, sw->sizes);
+        if (sw->nsizes <= 0) {
+            fprintf(stderr, "Error: lista de tamaños inválida: %s\n", arg);
+            exit(EXIT_FAILURE);
+        }
+        return 1;
+    }
+    if (strncmp(arg, "threads=", 8) == 0 || strncmp(arg, "workers=", 8) == 0) {
+        sw->nworkers = parseList(arg + 8, tmp);
+        if (sw->nworkers <= 0) {
+            fprintf(stderr, "Error: lista de hilos/procesos inválida: %s\n", arg);
+            exit(EXIT_FAILURE);
+        }
+        for (int i = 0; i < sw->nworkers; i++) sw->workers[i] = (int)tmp[i];
+        sw->workersGiven = 1;
+        return 1;
+    }
+    if (strncmp(arg, "reps=", 5) == 0 || strncmp(arg, "warmup=", 7) == 0) {
+        int isReps = (arg[0] == 'r');
+        value = arg + (isReps ? 5 : 7);
+        char* end;
+        long v = strtol(value, &end, 10);
+        if (end == value || *end != '\0' || v < (isReps ? 1 : 0)) {
+            fprintf(stderr, "Error: valor inválido: %s\n", arg);
+            exit(EXIT_FAILURE);
+        }
+        if (isReps) sw->cfg.reps = (int)v;
+        else sw->cfg.warmup = (int)v;
+        return 1;
+    }
+    if (strncmp(arg, "ci=", 3) == 0) {
+        sw->cfg.targetCI = parseFraction("ci", arg + 3);
+        return 1;
+    }
+    if (strncmp(arg, "minreps=", 8) == 0) {
+        char* end;
+        long v = strtol(arg + 8, &end, 10);
+        if (end == arg + 8 || *end != '\0' || v < 2) {
+            fprintf(stderr, "Error: valor inválido: %s (mínimo 2)\n", arg);
+            exit(EXIT_FAILURE);
+        }
+        sw->cfg.minReps = (int)v;
+        return 1;
+    }
+    if (strncmp(arg, "samples=", 8) == 0) {
+        sw->samplesFile = arg + 8;
+        return 1;
+    }
+    return 0;
+}
+
+void benchSweepCheck(const BenchSweep* sw, int usesWorkers) {
+    if (sw->nsizes == 0) {
+        fprintf(stderr, "Error: --sweep necesita sizes=a,b,...\n");
+        exit(EXIT_FAILURE);
+    }
+    if (!usesWorkers && sw->workersGiven) {
+        fprintf(stderr, "Error: este programa no usa threads=/workers=\n");
+        exit(EXIT_FAILURE);
+    }
+    if (usesWorkers && !sw->workersGiven) {
+        fprintf(stderr, "Error: --sweep necesita threads=a,b,...\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+void benchSweepParse(BenchSweep* sw, int argc, char* argv[], const BenchConfig* cfg, int usesWorkers) {
+    benchSweepInit(sw, cfg);
+    for (int a = 2; a < argc; a++) {
+        if (!benchSweepArg(sw, argv[a])) {
+            fprintf(stderr, "Error: opción no reconocida en --sweep: %s\n", argv[a]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    benchSweepCheck(sw, usesWorkers);
+}
+
+long benchSweepMaxSize(const BenchSweep* sw) {
+    long m = 0;
+    for (int i = 0; i < sw->nsizes; i++) if (sw->sizes[i] > m) m = sw->sizes[i];
+    return m;
+}
+
+int benchSweepMaxWorkers(const BenchSweep* sw) {
+    int m = 0;
+    for (int i = 0; i < sw->nworkers; i++) if (sw->workers[i] > m) m = sw->workers[i];
+    return m;
+}
@@ -0,0 +1,197 @@
+#ifndef HPCBENCH_H
+#define HPCBENCH_H
+
+#include <stdio.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+/* ==========================================
+ * hpcbench: medición común de todos los binarios
+ * ==========================================
+ * Corridas de calentamiento (no medidas) seguidas de repeticiones en el
+ * mismo proceso, cronometradas con CLOCK_MONOTONIC_RAW (no lo ajusta
+ * NTP). Uso:
+ *
+ *   BenchConfig cfg;
+ *   benchConfigInit(&cfg);             // BENCH_WARMUP / BENCH_REPS
+ *   BenchRun run;
+ *   benchRunInit(&run, &cfg);
+ *   while (benchRunNext(&run)) {
+ *       ...reiniciar el estado (fuera del tiempo)...
+ *       benchStart(&run);
+ *       ...región medida...
+ *       benchStop(&run);
+ *   }
+ *   benchRunFinish(&run);              // run.summary: min/mediana/media/...
+ *   benchWriteUnified(dir, &record, &run);
+ *   benchRunFree(&run);
+ *
+ * Por defecto 1 calentamiento y 5 repeticiones; BENCH_WARMUP=0 BENCH_REPS=1
+ * da una sola corrida (lo usan los scripts que solo miran el resultado).
+ *
+ * Modo adaptativo (BENCH_TARGET_CI=0.02): se repite hasta que el intervalo
+ * de confianza del 95% de la mediana mida a lo sumo ±2% de la mediana, con
+ * al menos BENCH_MIN_REPS (5) y como mucho BENCH_REPS repeticiones (50 si
+ * no se fija; un BENCH_REPS=1 explícito se respeta). Los tamaños estables cortan en pocas repeticiones y los
+ * ruidosos (N chico) siguen hasta el tope.
+ *
+ * benchRunFinish marca además los atípicos (fuera de Q1 - 1.5 IQR,
+ * Q3 + 1.5 IQR), la deriva (mediana del último tercio / primer tercio: una
+ * CPU que baja su frecuencia a mitad de la corrida se ve como deriva > 1) y
+ * los eventos de thermal throttling que cuente el kernel, si los expone. Con
+ * BENCH_SAMPLES=archivo.csv, benchWriteUnified agrega también el tiempo de
+ * cada repetición a ese archivo (mismo formato que benchWriteSamples).
+ * Las asignaciones de memoria dentro de la región medida se cuentan con
+ * memTrack.h; con BENCH_NO_ALLOC=1 cualquiera de ellas es un error.
+ */
+typedef struct {
+    int warmup;             // corridas descartadas
+    int reps;               // corridas medidas (BENCH_REPS_UNSET: según el modo)
+    int noAlloc;            // BENCH_NO_ALLOC=1: prohibido asignar en la región medida
+    double targetCI;        // semiancho relativo buscado del IC de la mediana (0: reps fijas)
+    int minReps;            // mínimo de repeticiones en modo adaptativo
+} BenchConfig;
+
+typedef struct {
+    int n;
+    double min;
+    double median;
+    double mean;
+    double stddev;          // desviación estándar muestral
+    double ci95;            // semiancho del intervalo de confianza del 95% de la media
+    double medianLo;        // IC del 95% de la mediana (estadísticos de orden)
+    double medianHi;
+    int outliers;           // fuera de las cercas de Tukey
+    double drift;           // mediana del último tercio / primer tercio (1 si n < 6)
+} BenchSummary;
+
+typedef struct {
+    BenchConfig cfg;
+    int iter;               // corrida actual (calentamientos incluidos)
+    int count;              // muestras registradas
+    double* samples;        // tiempo de pared de cada repetición (s)
+    double* sorted;         // las mismas, ordenadas (para cortar en modo adaptativo)
+    double t0;
+    double t1;              // fin de la última región medida (lo usa workerTimesJoin)
+    struct rusage ru0;
+    struct rusage ruc0;     // hijos esperados (fork) dentro de la región
+    double user_time;       // CPU de usuario por repetición (media, hijos incluidos; -1 si no se sabe)
+    double system_time;     // CPU de sistema por repetición (media; -1 si no se sabe)
+    long max_rss_kb;
+    long allocs0;
+    long timed_allocs;      // asignaciones dentro de las regiones medidas (suma)
+    long throttle0;         // contadores de throttling del kernel al empezar (-1: no hay)
+    long throttleEvents;    // durante la corrida (-1 si el kernel no los expone)
+    BenchSummary summary;
+} BenchRun;
+
+/* Fila del esquema unificado (Bench_Results.csv); machine_id y build_id
+ * remiten a Machine_Info.csv del mismo directorio (ver machineInfo.h) */
+typedef struct {
+    const char* project;    // caso1, caso2, reto2, ...
+    const char* program;    // secuencial, hilos, openmp_opt, ...
+    const char* variant;    // algoritmo o kernel concreto
+    long size;              // tamaño del problema (n, N, muestras)
+    int workers;            // hilos o procesos
+    double ops;             // operaciones por repetición (0 si no aplica)
+    double elements;        // elementos del resultado por repetición (0 si no aplica)
+    double bytes;           // tráfico mínimo de memoria por repetición (0 si no aplica)
+} BenchRecord;
+
+#define BENCH_CSV_HEADER \
+    "project,program,variant,size,workers,warmup,reps,min_s,median_s,mean_s,stddev_s,ci95_s," \
+    "user_s,system_s,max_rss_mb,ops,gops,machine_id,build_id,timed_allocs," \
+    "median_lo_s,median_hi_s,outliers,drift,throttle_events"
+
+/* BenchConfig.reps sin BENCH_REPS ni reps=: benchConfigReps decide */
+#define BENCH_REPS_UNSET 0
+
+void benchConfigInit(BenchConfig* cfg);
+/* Repeticiones efectivas: las fijadas, o las de por defecto del modo */
+int benchConfigReps(const BenchConfig* cfg);
+
+void benchRunInit(BenchRun* run, const BenchConfig* cfg);
+int benchRunNext(BenchRun* run);
+int benchIsWarmup(const BenchRun* run);
+void benchStart(BenchRun* run);
+void benchStop(BenchRun* run);
+void benchRunFinish(BenchRun* run);
+void benchRunFree(BenchRun* run);
+
+/* Tras benchRunFinish: el trabajo corrió en procesos que el padre no espera
+ * por repetición (pool persistente), así que RUSAGE_CHILDREN no lo ve. Deja
+ * user/system en -1, que se escriben vacíos en el CSV. */
+void benchCpuTimeUnknown(BenchRun* run);
+
+/* Semiancho del IC de la mediana relativo a la mediana (0 si no hay muestras) */
+double benchMedianRelCI(const double* sorted, int n);
+
+/* ==========================================
+ * Barrido en el mismo proceso (--sweep)
+ * ==========================================
+ *   prog --sweep sizes=a,b,c [threads=1,2,4] [reps=R] [warmup=W] [samples=archivo.csv]
+ *                [ci=0.02] [minreps=M]     // modo adaptativo: reps= es el tope
+ * Recorre todas las combinaciones tamaño x hilos/procesos sin relanzar el
+ * binario: las matrices, semillas y el pool de OpenMP se reutilizan y
+ * cada configuración se agrega al CSV apenas termina.
+ */
+#define BENCH_SWEEP_MAX 64
+
+typedef struct {
+    int nsizes;
+    long sizes[BENCH_SWEEP_MAX];
+    int nworkers;
+    int workers[BENCH_SWEEP_MAX];
+    int workersGiven;       // 0 si no se pasó threads=/workers=
+    BenchConfig cfg;        // reps=/warmup=/ci=/minreps= sobrescriben las variables BENCH_*
+    const char* samplesFile;// una fila por repetición (opcional)
+} BenchSweep;
+
+int benchIsSweep(int argc, char* argv[]);
+/* Lee argv[2..] completo; sale con error ante una opción desconocida */
+void benchSweepParse(BenchSweep* sw, int argc, char* argv[], const BenchConfig* cfg, int usesWorkers);
+void benchSweepInit(BenchSweep* sw, const BenchConfig* cfg);
+int benchSweepArg(BenchSweep* sw, const char* arg);     // 1 si la reconoce
+void benchSweepCheck(const BenchSweep* sw, int usesWorkers);
+long benchSweepMaxSize(const BenchSweep* sw);
+int benchSweepMaxWorkers(const BenchSweep* sw);
+
+/* Tiempo de cada repetición medida (project,...,rep,time_s,machine_id).
+ * No usar el mismo archivo en samples= y en BENCH_SAMPLES: quedaría duplicado */
+void benchWriteSamples(const char* filename, const BenchRecord* rec, const BenchRun* run);
+
+void benchSummarize(const double* samples, int n, BenchSummary* out);
+void benchPrintSummary(const BenchRun* run);
+void benchWriteUnified(const char* dirPath, const BenchRecord* rec, const BenchRun* run);
+
+/* Por segundo de la mediana: rec->ops / 1e9, rec->bytes / 1e9 (0 sin mediana) */
+double benchGops(const BenchRecord* rec, const BenchRun* run);
+double benchBandwidthGBs(const BenchRecord* rec, const BenchRun* run);
+
+/* Tiempos, rendimiento y memoria de la corrida en consola, y el resumen */
+void benchPrintRecord(const BenchRecord* rec, const BenchRun* run);
+
+/* CSV históricos de cada programa (Secuencial_Results.csv, tiempos_Nhilos.csv,
+ * OpenMP_Results.csv, ...). `columns` es la cabecera: se asegura en el
+ * archivo y las columnas conocidas se llenan desde rec y run, en ese orden,
+ * hasta la primera que no lo es (p. ej. algorithm, que conserva el nombre
+ * histórico de cada programa). Desde ahí escribe el llamador en el FILE*
+ * devuelto y cierra la fila con benchLegacyEnd. NULL si no se pudo abrir.
+ *
+ *   tamaño:     size, matrix_size, N, tamañoMatriz
+ *   workers:    threads, num_threads, num_procesos, #procesos
+ *   tiempos:    real_time (mediana), user_time, system_time, total_cpu_time,
+ *               también con _sec
+ *   derivadas:  total_operations, gops, performance_gops, bandwidth_gbs,
+ *               bytes_moved, elements_per_second_million(s), memory_used_mb
+ */
+FILE* benchLegacyRow(const char* filename, const char* columns,
+                     const BenchRecord* rec, const BenchRun* run);
+void benchLegacyEnd(FILE* f);
+
+/* Utilidades que antes copiaba cada programa */
+double benchNow(void);
+double benchTimevalToSeconds(struct timeval tv);
+void benchEnsureDir(const char* path);
+
+#endif
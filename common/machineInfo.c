@@ -0,0 +1,269 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/utsname.h>
+
+#include "machineInfo.h"
+#include "csvUtils.h"
+#include "hpcbench.h"
+
+#ifndef BUILD_FLAGS
+#define BUILD_FLAGS "desconocido"
+#endif
+#ifndef GIT_COMMIT
+#define GIT_COMMIT "desconocido"
+#endif
+
+#define MAX_TOPOLOGY_CPUS 1024
+
+/* ==========================================
+ * Lectura de /proc y /sys
+ * ========================================== */
+
+/* Primera línea del archivo, sin salto; 0 si no existe */
+static int readLine(const char* path, char* out, size_t len) {
+    FILE* f = fopen(path, "r");
+    if (f == NULL) return 0;
+    int ok = fgets(out, (int)len, f) != NULL;
+    fclose(f);
+    if (ok) out[strcspn(out, "\r\n")] = '\0';
+    return ok;
+}
+
+static int readInt(const char* path, int fallback) {
+    char buf[64];
+    return readLine(path, buf, sizeof(buf)) ? atoi(buf) : fallback;
+}
+
+/* Las columnas van a un CSV sin comillas: las comas pasan a espacios */
+static void sanitize(char* s) {
+    for (; *s; s++) if (*s == ',' || *s == '\n') *s = ' ';
+}
+
+static void readCpuModel(char* out, size_t len) {
+    snprintf(out, len, "desconocido");
+    FILE* f = fopen("/proc/cpuinfo", "r");
+    if (f == NULL) return;
+    char line[512];
+    while (fgets(line, sizeof(line), f)) {
+        if (strncmp(line, "model name", 10) != 0) continue;
+        char* v = strchr(line, ':');
+        if (v == NULL) break;
+        v++;
+        while (*v == ' ') v++;
+        v[strcspn(v, "\n")] = '\0';
+        snprintf(out, len, "%s", v);
+        break;
+    }
+    fclose(f);
+}
+
+/* Núcleos físicos y sockets a partir de la topología de cada CPU lógica */
+static void readTopology(MachineInfo* mi) {
+    static int pkgs[MAX_TOPOLOGY_CPUS], cores[MAX_TOPOLOGY_CPUS];
+    int ncores = 0, nsockets = 0;
+    int n = mi->threads < MAX_TOPOLOGY_CPUS ? mi->threads : MAX_TOPOLOGY_CPUS;
+    char path[128];
+
+    for (int cpu = 0; cpu < n; cpu++) {
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", cpu);
+        int pkg = readInt(path, 0);
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/core_id", cpu);
+        int core = readInt(path, cpu);
+
+        int seenPkg = 0, seenCore = 0;
+        for (int i = 0; i < ncores; i++) {
+            if (pkgs[i] != pkg) continue;
+            seenPkg = 1;
+            if (cores[i] == core) { seenCore = 1; break; }
+        }
+        if (!seenPkg) nsockets++;
+        if (!seenCore) {
+            pkgs[ncores] = pkg;
+            cores[ncores] = core;
+            ncores++;
+        }
+    }
+    mi->sockets = nsockets > 0 ? nsockets : 1;
+    mi->cores = ncores > 0 ? ncores : mi->threads;
+}
+
+/* Tamaños de caché de la CPU 0 ("32K", "1M", ...) */
+static void readCaches(MachineInfo* mi) {
+    char path[128], buf[64];
+    for (int idx = 0; idx < 8; idx++) {
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/level", idx);
+        int level = readInt(path, -1);
+        if (level < 0) break;
+
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/type", idx);
+        if (!readLine(path, buf, sizeof(buf))) continue;
+        if (strcmp(buf, "Instruction") == 0) continue;
+
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/size", idx);
+        if (!readLine(path, buf, sizeof(buf))) continue;
+        char* unit;
+        long kb = strtol(buf, &unit, 10);
+        if (*unit == 'M') kb *= 1024;
+
+        if (level == 1) mi->l1d_kb = (int)kb;
+        else if (level == 2) mi->l2_kb = (int)kb;
+        else if (level == 3) mi->l3_kb = (int)kb;
+    }
+}
+
+static int countNumaNodes(void) {
+    char path[128];
+    int nodes = 0;
+    for (int n = 0; n < 256; n++) {
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d", n);
+        if (access(path, F_OK) != 0) break;
+        nodes++;
+    }
+    return nodes > 0 ? nodes : 1;
+}
+
+static void readCompiler(char* out, size_t len) {
+#if defined(__clang__)
+    snprintf(out, len, "clang %s", __clang_version__);
+#elif defined(__GNUC__)
+    snprintf(out, len, "gcc %s", __VERSION__);
+#else
+    snprintf(out, len, "desconocido");
+#endif
+}
+
+/* ==========================================
+ * Identificadores
+ * ========================================== */
+static unsigned fnv1a(unsigned h, const char* s) {
+    for (; *s; s++) {
+        h ^= (unsigned char)*s;
+        h *= 16777619u;
+    }
+    return h ^ 0xffu;       // separador entre campos
+}
+
+static unsigned fnv1aInt(unsigned h, long v) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%ld", v);
+    return fnv1a(h, buf);
+}
+
+static void computeIds(MachineInfo* mi) {
+    unsigned h = 2166136261u;
+    h = fnv1a(h, mi->host);
+    h = fnv1a(h, mi->cpu_model);
+    h = fnv1aInt(h, mi->sockets);
+    h = fnv1aInt(h, mi->cores);
+    h = fnv1aInt(h, mi->threads);
+    h = fnv1aInt(h, mi->l1d_kb);
+    h = fnv1aInt(h, mi->l2_kb);
+    h = fnv1aInt(h, mi->l3_kb);
+    h = fnv1aInt(h, mi->numa_nodes);
+    h = fnv1aInt(h, mi->mem_mb);
+    h = fnv1a(h, mi->governor);
+    h = fnv1a(h, mi->kernel);
+    snprintf(mi->machine_id, sizeof(mi->machine_id), "%08x", h);
+
+    h = 2166136261u;
+    h = fnv1a(h, mi->compiler);
+    h = fnv1a(h, mi->cflags);
+    h = fnv1a(h, mi->git_commit);
+    snprintf(mi->build_id, sizeof(mi->build_id), "%08x", h);
+}
+
+/* ==========================================
+ * API
+ * ========================================== */
+const MachineInfo* machineInfoGet(void) {
+    static MachineInfo mi;
+    static int loaded = 0;
+    if (loaded) return &mi;
+
+    memset(&mi, 0, sizeof(mi));
+    if (gethostname(mi.host, sizeof(mi.host)) != 0) snprintf(mi.host, sizeof(mi.host), "desconocido");
+    mi.host[sizeof(mi.host) - 1] = '\0';
+
+    readCpuModel(mi.cpu_model, sizeof(mi.cpu_model));
+    mi.threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (mi.threads < 1) mi.threads = 1;
+    readTopology(&mi);
+    readCaches(&mi);
+    mi.numa_nodes = countNumaNodes();
+
+    long pages = sysconf(_SC_PHYS_PAGES), pageSize = sysconf(_SC_PAGESIZE);
+    mi.mem_mb = (pages > 0 && pageSize > 0) ? (long)((double)pages * pageSize / (1024.0 * 1024.0)) : 0;
+
+    /* Sin cpufreq (VMs, contenedores) no hay gobernador que reportar */
+    if (!readLine("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor", mi.governor, sizeof(mi.governor)))
+        snprintf(mi.governor, sizeof(mi.governor), "n/a");
+
+    struct utsname un;
+    if (uname(&un) == 0) snprintf(mi.kernel, sizeof(mi.kernel), "%s %s", un.sysname, un.release);
+    else snprintf(mi.kernel, sizeof(mi.kernel), "desconocido");
+
+    readCompiler(mi.compiler, sizeof(mi.compiler));
+    snprintf(mi.cflags, sizeof(mi.cflags), "%s", BUILD_FLAGS);
+    snprintf(mi.git_commit, sizeof(mi.git_commit), "%s", GIT_COMMIT);
+
+    sanitize(mi.host);
+    sanitize(mi.cpu_model);
+    sanitize(mi.governor);
+    sanitize(mi.kernel);
+    sanitize(mi.compiler);
+    sanitize(mi.cflags);
+    sanitize(mi.git_commit);
+
+    computeIds(&mi);
+    loaded = 1;
+    return &mi;
+}
+
+/* ¿Ya hay una fila con este par machine_id,build_id? */
+static int alreadyRecorded(const char* filename, const MachineInfo* mi) {
+    FILE* f = fopen(filename, "r");
+    if (f == NULL) return 0;
+    char key[32], line[1024];
+    snprintf(key, sizeof(key), "%s,%s,", mi->machine_id, mi->build_id);
+    int found = 0;
+    while (!found && fgets(line, sizeof(line), f))
+        found = strncmp(line, key, strlen(key)) == 0;
+    fclose(f);
+    return found;
+}
+
+void machineInfoWrite(const char* dirPath) {
+    const MachineInfo* mi = machineInfoGet();
+    benchEnsureDir(dirPath);
+    char filename[512];
+    snprintf(filename, sizeof(filename), "%s/Machine_Info.csv", dirPath);
+    ensureCSVHeader(filename, MACHINE_INFO_CSV_HEADER);
+    if (alreadyRecorded(filename, mi)) return;
+
+    FILE* f = fopen(filename, "a");
+    if (f == NULL) {
+        fprintf(stderr, "Error: no se pudo abrir %s\n", filename);
+        return;
+    }
+    fprintf(f, "%s,%s,%s,%s,%d,%d,%d,%d,%d,%d,%d,%ld,%s,%s,%s,%s,%s\n",
+            mi->machine_id, mi->build_id, mi->host, mi->cpu_model,
+            mi->sockets, mi->cores, mi->threads, mi->l1d_kb, mi->l2_kb, mi->l3_kb,
+            mi->numa_nodes, mi->mem_mb, mi->governor, mi->kernel,
+            mi->compiler, mi->cflags, mi->git_commit);
+    fclose(f);
+    machineInfoPrint(mi);
+}
+
+void machineInfoPrint(const MachineInfo* mi) {
+    printf("\nMáquina %s (%s):\n", mi->machine_id, mi->host);
+    printf("  CPU:        %s\n", mi->cpu_model);
+    printf("  Topología:  %d socket(s), %d núcleos, %d hilos, %d nodo(s) NUMA\n",
+           mi->sockets, mi->cores, mi->threads, mi->numa_nodes);
+    printf("  Cachés:     L1d %d KB, L2 %d KB, L3 %d KB\n", mi->l1d_kb, mi->l2_kb, mi->l3_kb);
+    printf("  Memoria:    %ld MB, gobernador %s\n", mi->mem_mb, mi->governor);
+    printf("  Kernel:     %s\n", mi->kernel);
+    printf("Compilación %s: %s [%s] commit %s\n",
+           mi->build_id, mi->compiler, mi->cflags, mi->git_commit);
+}
@@ -0,0 +1,52 @@
+#ifndef MACHINE_INFO_H
+#define MACHINE_INFO_H
+
+/* ==========================================
+ * Huella de máquina y de compilación
+ * ==========================================
+ * Cada fila de Bench_Results.csv lleva dos identificadores cortos:
+ *   machine_id: CPU, núcleos/hilos, cachés, nodos NUMA, memoria,
+ *               gobernador de frecuencia, kernel y host
+ *   build_id:   compilador, flags y commit de git
+ * El detalle de cada par se guarda una sola vez en Machine_Info.csv del
+ * mismo directorio, así los scripts pueden unir ambas tablas y comparar
+ * solo corridas hechas en condiciones equivalentes.
+ *
+ * Los flags y el commit llegan desde el Makefile:
+ *   -DBUILD_FLAGS='"$(CFLAGS)"' -DGIT_COMMIT='"$(GIT_COMMIT)"'
+ * Si se compila a mano quedan como "desconocido".
+ */
+typedef struct {
+    char host[64];
+    char cpu_model[128];
+    int sockets;
+    int cores;              // núcleos físicos
+    int threads;            // CPUs lógicas en línea
+    int l1d_kb;
+    int l2_kb;
+    int l3_kb;
+    int numa_nodes;
+    long mem_mb;
+    char governor[32];
+    char kernel[136];       // uname: sistema y versión
+    char compiler[64];
+    char cflags[256];
+    char git_commit[48];
+    char machine_id[9];     // hash FNV-1a de 32 bits en hexadecimal
+    char build_id[9];
+} MachineInfo;
+
+/* Se lee una vez por proceso; las llamadas siguientes devuelven la copia */
+const MachineInfo* machineInfoGet(void);
+
+/* Agrega la fila de esta máquina/compilación a <dirPath>/Machine_Info.csv
+ * si todavía no está (y en ese caso la imprime) */
+void machineInfoWrite(const char* dirPath);
+
+void machineInfoPrint(const MachineInfo* mi);
+
+#define MACHINE_INFO_CSV_HEADER \
+    "machine_id,build_id,host,cpu_model,sockets,cores,threads,l1d_kb,l2_kb,l3_kb," \
+    "numa_nodes,mem_mb,governor,kernel,compiler,cflags,git_commit"
+
+#endif
@@ -0,0 +1,471 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "mcEngine.h"
+#include "mcTarget.h"
+#include "perfCounters.h"
+#include "csvUtils.h"
+#include "roofline.h"
+#include "hpcbench.h"
+#include "scaling.h"
+#include "workQueue.h"
+#include "procPool.h"
+#include "trace.h"
+
+/* ==========================================
+ * Problemas
+ * ========================================== */
+typedef struct {
+    const char* name;       // dartboard, needles (nombre de binario y variante)
+    const char* label;      // Dartboard, Needles (carpetas históricas y consola)
+    McProblem problem;
+    int flopsPerSample;     // operaciones de punto flotante por muestra (roofline)
+} McProblemInfo;
+
+static const McProblemInfo problems[] = {
+    /* 2 conversiones a [0,1), 2 productos, 1 suma y 1 comparación */
+    { "dartboard", "Dartboard", { 0, 0.0, 0.0 }, 6 },
+    /* 2 conversiones a [0,1), 2 escalados, seno (como 1), producto y comparación */
+    { "needles", "Needles", { 1, MC_NEEDLE_LEN, MC_NEEDLE_DIST }, 7 },
+};
+#define MC_PROBLEMS ((int)(sizeof(problems) / sizeof(problems[0])))
+
+/* ==========================================
+ * Trabajo de una repetición
+ * ========================================== */
+
+/* Resultado de un worker: una línea de caché cada uno */
+typedef struct {
+    long hits;
+    double start;               // benchNow al empezar y al terminar
+    double end;
+} __attribute__((aligned(64))) McSlot;
+
+/* Se crea una vez por programa en un mmap compartido, antes del pool de
+ * procesos, y sirve a todas las configuraciones del barrido */
+typedef struct {
+    const McProblemInfo* info;
+    McKernel kernel;
+    uint64_t seed;              // semilla común; el worker usa el flujo de su id
+    int workers;                // los de la configuración en curso
+    McTarget* target;           // NULL salvo con MC_TOL
+    WorkQueue* queue;           // bloques de muestras por reclamar
+    ProcPool* pool;             // backend procesos; NULL con PROC_POOL=0
+    McSlot slots[];             // uno por worker, hasta el máximo del barrido
+} McJob;
+
+/* El mismo worker para todos los backends */
+static void mcWorker(McJob* job, int id) {
+    TRACE_BEGIN_ARG("worker", id);
+    job->slots[id].start = benchNow();
+    McStream stream;
+    mcStreamInit(&stream, job->kernel, job->seed, id);
+
+    /* Bloques del contador común hasta agotar [0, N) */
+    long begin, end, hits = 0;
+    int more = 1;
+    while (more && workQueueClaim(job->queue, id, &begin, &end)) {
+        TRACE_BEGIN_ARG("chunk", begin);
+        if (job->target == NULL) hits += mcRun(&stream, &job->info->problem, begin, end);
+        else more = mcTargetWork(job->target, &stream, begin, end);
+        TRACE_END("chunk");
+    }
+    job->slots[id].hits = hits;
+    job->slots[id].end = benchNow();
+    TRACE_END("worker");
+}
+
+/* ==========================================
+ * Backends
+ * ========================================== */
+static void launchSecuencial(McJob* job) {
+    mcWorker(job, 0);
+}
+
+typedef struct {
+    McJob* job;
+    int id;
+} McThreadArg;
+
+static void* threadMain(void* arg) {
+    McThreadArg* a = (McThreadArg*)arg;
+    TRACE_THREAD_NAME("hilo %d", a->id);
+    mcWorker(a->job, a->id);
+    return NULL;
+}
+
+static void launchHilos(McJob* job) {
+    pthread_t threads[job->workers];
+    McThreadArg args[job->workers];
+    for (int t = 0; t < job->workers; t++) {
+        args[t].job = job;
+        args[t].id = t;
+        if (pthread_create(&threads[t], NULL, threadMain, &args[t]) != 0) {
+            perror("pthread_create");
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (int t = 0; t < job->workers; t++) pthread_join(threads[t], NULL);
+}
+
+static void poolTask(void* arg, int worker) {
+    mcWorker((McJob*)arg, worker);
+}
+
+/* El trabajo, la cola y el objetivo viven en mmap compartidos creados
+ * antes de los hijos: los del pool los ven igual que los de un fork nuevo */
+static void launchProcesos(McJob* job) {
+    if (job->pool != NULL) {
+        procPoolRun(job->pool, job->workers, poolTask, job);
+        return;
+    }
+    for (int p = 0; p < job->workers; p++) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            perror("fork");
+            exit(EXIT_FAILURE);
+        }
+        if (pid == 0) {
+            mcWorker(job, p);
+            _exit(0);
+        }
+    }
+    for (int p = 0; p < job->workers; p++) wait(NULL);
+}
+
+#ifdef _OPENMP
+static void launchOpenmp(McJob* job) {
+    #pragma omp parallel num_threads(job->workers)
+    {
+        TRACE_THREAD_NAME("omp %d", omp_get_thread_num());
+        mcWorker(job, omp_get_thread_num());
+    }
+}
+#define LAUNCH_OPENMP launchOpenmp
+#else
+#define LAUNCH_OPENMP NULL      // binario compilado sin -fopenmp
+#endif
+
+typedef struct {
+    const char* name;       // nombre de binario, columna program del CSV unificado
+    void (*launch)(McJob* job);
+} McBackendInfo;
+
+static const McBackendInfo backends[MC_BACKENDS] = {
+    [MC_SECUENCIAL] = { "secuencial", launchSecuencial },
+    [MC_HILOS]      = { "hilos",      launchHilos },
+    [MC_PROCESOS]   = { "procesos",   launchProcesos },
+    [MC_OPENMP]     = { "openmp",     LAUNCH_OPENMP },
+};
+
+/* ==========================================
+ * CSV históricos de cada backend
+ * ========================================== */
+typedef struct {
+    const char* project;
+    const char* resultsDir;
+    const McProblemInfo* info;
+    McBackend backend;
+    McJob* job;
+    PerfCounters counters;
+    ScalingStudy scaling;
+} McProgram;
+
+static void legacyPath(const McProgram* pg, int workers, char* out, size_t size) {
+    char dir[512];
+    const char* label = pg->info->label;
+    switch (pg->backend) {
+    case MC_SECUENCIAL:
+        snprintf(dir, sizeof(dir), "%s/secuencial/Secuencial_%s_Data", pg->resultsDir, label);
+        snprintf(out, size, "%s/%s_Results.csv", dir, label);
+        break;
+    case MC_HILOS:
+        snprintf(dir, sizeof(dir), "%s/hilos/Hilos_%s_Data", pg->resultsDir, label);
+        snprintf(out, size, "%s/results_%dhilos.csv", dir, workers);
+        break;
+    case MC_PROCESOS:
+        snprintf(dir, sizeof(dir), "%s/procesos/Procesos_%s_Data", pg->resultsDir, label);
+        snprintf(out, size, "%s/results_%dprocesos.csv", dir, workers);
+        break;
+    default:
+        snprintf(dir, sizeof(dir), "%s/openmp/%s_Data", pg->resultsDir, label);
+        snprintf(out, size, "%s/OpenMP_Results.csv", dir);
+        break;
+    }
+    benchEnsureDir(dir);
+}
+
+static void legacyWrite(const McProgram* pg, const char* filename, long N, int workers,
+                        double pi, const BenchRun* run, const char* algorithm) {
+    switch (pg->backend) {
+    case MC_SECUENCIAL:
+        ensureCSVHeader(filename, "N,pi_est,user_time," PERF_CSV_HEADER);
+        break;
+    case MC_HILOS:
+        ensureCSVHeader(filename, "N,num_threads,pi_est,real_time," PERF_CSV_HEADER);
+        break;
+    case MC_PROCESOS:
+        ensureCSVHeader(filename, "N,num_procesos,pi_est,real_time," PERF_CSV_HEADER);
+        break;
+    default:
+        ensureCSVHeader(filename,
+            "size,threads,real_time,user_time,system_time,total_cpu_time,"
+            "total_operations,gops,elements_per_second_millions,memory_used_mb,algorithm,pi_est,"
+            PERF_CSV_HEADER);
+        break;
+    }
+
+    FILE* f = fopen(filename, "a");
+    if (f == NULL) {
+        perror("fopen");
+        exit(EXIT_FAILURE);
+    }
+    const double real = run->summary.median;
+    switch (pg->backend) {
+    case MC_SECUENCIAL:
+        fprintf(f, "%ld,%.9f,%.9f,", N, pi, run->user_time);
+        break;
+    case MC_HILOS:
+    case MC_PROCESOS:
+        fprintf(f, "%ld,%d,%.9f,%.9f,", N, workers, pi, real);
+        break;
+    default:
+        fprintf(f, "%ld,%d,%.9f,%.9f,%.9f,%.9f,%ld,%.6f,%.6f,%ld,%s,%.9f,",
+                N, workers, real, run->user_time, run->system_time,
+                run->user_time + run->system_time, N, N / real / 1e9, N / real / 1e6,
+                run->max_rss_kb / 1024, algorithm, pi);
+        break;
+    }
+    perfCountersWriteCSV(f, &pg->counters);
+    fputc('\n', f);
+    fclose(f);
+}
+
+/* ==========================================
+ * Una configuración completa: mide, guarda en los CSV y reporta
+ * ========================================== */
+static void runBenchmark(McProgram* pg, long N, int workers, const BenchConfig* benchConfig,
+                         const char* samplesFile) {
+    const McBackendInfo* backend = &backends[pg->backend];
+    const McProblemInfo* info = pg->info;
+    McJob* job = pg->job;
+    job->workers = workers;
+
+    WorkerTimes times;
+    workerTimesInit(&times, workers, 0);
+
+    BenchRun run;
+    benchRunInit(&run, benchConfig);
+    perfCountersReset(&pg->counters);
+    while (benchRunNext(&run)) {
+        /* Preparación fuera de la región medida; el objetivo al final porque
+         * su reloj (tiempo hasta la precisión) arranca en mcTargetReset */
+        workQueueReset(job->queue, workers, N);
+        memset(job->slots, 0, (size_t)workers * sizeof(McSlot));
+        perfCountersStart(&pg->counters);
+        if (job->target != NULL) mcTargetReset(job->target, N);
+        benchStart(&run);
+
+        backend->launch(job);
+
+        benchStop(&run);
+        perfCountersStop(&pg->counters);
+        if (!benchIsWarmup(&run)) perfCountersAccumulate(&pg->counters);
+        for (int w = 0; w < workers; w++) {
+            times.start[w] = job->slots[w].start;
+            times.end[w] = job->slots[w].end;
+        }
+        workerTimesJoin(&times, &run);
+    }
+    benchRunFinish(&run);
+    if (job->pool != NULL) benchCpuTimeUnknown(&run);
+
+    long hits = 0;
+    for (int w = 0; w < workers; w++) hits += job->slots[w].hits;
+    const double pi = job->target != NULL ? mcTargetPi(job->target, NULL, NULL)
+                                         : mcPiFromHits(&info->problem, job->kernel, hits, N);
+    const double seconds = run.summary.median;
+
+    char base[64], variant[32], algorithm[64];
+    snprintf(base, sizeof(base), "%s_%s", backend->name, info->name);
+    mcVariantName(variant, sizeof(variant), info->name, job->kernel);
+    mcVariantName(algorithm, sizeof(algorithm), base, job->kernel);
+
+    char filename[640];
+    legacyPath(pg, workers, filename, sizeof(filename));
+    legacyWrite(pg, filename, N, workers, pi, &run, algorithm);
+
+    printf("PI %s %s workers=%d: %.9f\n", info->label, backend->name, workers, pi);
+    printf("Tiempo real: %.9f s\n", seconds);
+    if (job->pool != NULL) printf("Tiempo usuario/sistema: n/d con el pool de procesos (PROC_POOL=0 para medirlo)\n");
+    else printf("Tiempo usuario: %.9f s | sistema: %.9f s\n", run.user_time, run.system_time);
+    mcPrintThroughput(job->kernel, job->target != NULL ? job->target->samples : N, workers, seconds);
+    benchPrintSummary(&run);
+    perfCountersPrint(&pg->counters);
+    if (pg->backend != MC_SECUENCIAL) workQueuePrint(job->queue);
+    printf("Guardado en: %s\n", filename);
+
+    BenchRecord record = {pg->project, backend->name, variant, N, workers,
+                          (double)N * info->flopsPerSample};
+    benchWriteUnified(pg->resultsDir, &record, &run);
+    if (job->target != NULL) mcTargetReport(job->target, pg->resultsDir, &record, &run);
+    benchWriteSamples(samplesFile, &record, &run);
+    if (pg->backend != MC_SECUENCIAL) scalingAdd(&pg->scaling, &record, &run, &times);
+
+    /* Monte Carlo sin arreglos: el tráfico del modelo es 0 (intensidad infinita) */
+    char rooflineDir[512];
+    snprintf(rooflineDir, sizeof(rooflineDir), "%s/roofline", pg->resultsDir);
+    rooflineReport(rooflineDir, algorithm, N, workers, ROOFLINE_FLOAT,
+                   (double)N * info->flopsPerSample, 0.0, &run.summary, &pg->counters);
+
+    workerTimesFree(&times);
+    benchRunFree(&run);
+}
+
+/* ==========================================
+ * Programa
+ * ========================================== */
+static const McProblemInfo* findProblem(const char* name, size_t len) {
+    for (int p = 0; p < MC_PROBLEMS; p++)
+        if (strlen(problems[p].name) == len && strncmp(problems[p].name, name, len) == 0)
+            return &problems[p];
+    return NULL;
+}
+
+static int findBackend(const char* name, size_t len) {
+    for (int b = 0; b < MC_BACKENDS; b++)
+        if (strlen(backends[b].name) == len && strncmp(backends[b].name, name, len) == 0)
+            return b;
+    return -1;
+}
+
+static void usage(const char* self, const char* program, int usesWorkers) {
+    if (program == NULL) {
+        fprintf(stderr, "Uso: %s <dartboard|needles> <secuencial|hilos|procesos|openmp> <N> [workers]\n"
+                        "       %s <dartboard|needles> <backend> --sweep sizes=a,b,... [threads=a,b,...] "
+                        "[reps=R] [warmup=W] [samples=archivo.csv]\n", self, self);
+    } else if (usesWorkers) {
+        fprintf(stderr, "Uso: %s <N> <workers>\n"
+                        "       %s --sweep sizes=a,b,... threads=a,b,... [reps=R] [warmup=W] [samples=archivo.csv]\n",
+                self, self);
+    } else {
+        fprintf(stderr, "Uso: %s <N>\n"
+                        "       %s --sweep sizes=a,b,... [reps=R] [warmup=W] [samples=archivo.csv]\n",
+                self, self);
+    }
+}
+
+int mcMain(const char* project, const char* resultsDir, const char* program,
+           int argc, char* argv[]) {
+    McProgram pg;
+    pg.project = project;
+    pg.resultsDir = resultsDir;
+    const char* self = argv[0];
+
+    int backend;
+    if (program != NULL) {
+        /* <backend>_<problema>, fijado al compilar */
+        const char* sep = strchr(program, '_');
+        if (sep == NULL || (backend = findBackend(program, sep - program)) < 0 ||
+            (pg.info = findProblem(sep + 1, strlen(sep + 1))) == NULL) {
+            fprintf(stderr, "Error: programa Monte Carlo desconocido: %s\n", program);
+            return EXIT_FAILURE;
+        }
+    } else {
+        if (argc < 3 || (pg.info = findProblem(argv[1], strlen(argv[1]))) == NULL ||
+            (backend = findBackend(argv[2], strlen(argv[2]))) < 0) {
+            usage(self, NULL, 1);
+            return EXIT_FAILURE;
+        }
+        /* Lo que sigue se lee igual que en los binarios de un solo backend */
+        argc -= 2;
+        argv += 2;
+    }
+    pg.backend = (McBackend)backend;
+    if (backends[backend].launch == NULL) {
+        fprintf(stderr, "Error: backend %s no disponible (compilado sin -fopenmp)\n",
+                backends[backend].name);
+        return EXIT_FAILURE;
+    }
+    const int usesWorkers = pg.backend != MC_SECUENCIAL;
+
+    BenchConfig benchConfig;
+    benchConfigInit(&benchConfig);
+
+    /* --sweep: todas las combinaciones en un solo proceso, sin relanzar; una
+     * corrida suelta es un barrido de una sola configuración */
+    BenchSweep sweep;
+    if (benchIsSweep(argc, argv)) {
+        benchSweepParse(&sweep, argc, argv, &benchConfig, usesWorkers);
+    } else if (argc < 2 || (usesWorkers && argc < 3)) {
+        usage(self, program, usesWorkers);
+        return EXIT_FAILURE;
+    } else {
+        benchSweepInit(&sweep, &benchConfig);
+        sweep.nsizes = 1;
+        sweep.sizes[0] = atol(argv[1]);
+        if (usesWorkers) sweep.workers[0] = atoi(argv[2]);
+    }
+    for (int s = 0; s < sweep.nsizes; s++)
+    for (int w = 0; w < sweep.nworkers; w++) {
+        if (sweep.sizes[s] < 1 || sweep.workers[w] < 1) {
+            fprintf(stderr, "Error: N=%ld y workers=%d deben ser positivos\n",
+                    sweep.sizes[s], sweep.workers[w]);
+            return EXIT_FAILURE;
+        }
+    }
+    /* Sobol y Halton indexan los puntos con 32 bits; con MC_TOL el tope de
+     * muestras del objetivo es el mismo N */
+    const McKernel kernel = mcKernelFromEnv();
+    if ((kernel == MC_SOBOL || kernel == MC_HALTON) && benchSweepMaxSize(&sweep) > QMC_MAX_POINTS) {
+        fprintf(stderr, "Error: N=%ld supera el máximo de %ld puntos de MC_KERNEL=%s (2^32)%s\n",
+                benchSweepMaxSize(&sweep), QMC_MAX_POINTS, mcKernelName(kernel),
+                getenv("MC_TOL") != NULL ? "; con MC_TOL N es el tope de muestras" : "");
+        return EXIT_FAILURE;
+    }
+    const int maxWorkers = usesWorkers ? benchSweepMaxWorkers(&sweep) : 1;
+
+    /* Antes de procPoolCreate: los hijos del pool heredan los contadores */
+    perfCountersOpen(&pg.counters);
+    scalingInit(&pg.scaling);
+
+    /* Todo lo que leen los workers, creado antes del pool de procesos */
+    const size_t jobBytes = sizeof(McJob) + (size_t)maxWorkers * sizeof(McSlot);
+    McJob* job = mmap(NULL, jobBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (job == MAP_FAILED) {
+        perror("mmap");
+        return EXIT_FAILURE;
+    }
+    job->info = pg.info;
+    job->kernel = kernel;
+    job->seed = rngSeedFromEnv();
+    job->target = mcTargetFromEnv(&pg.info->problem, job->kernel, benchSweepMaxSize(&sweep));
+    job->queue = workQueueCreate(maxWorkers);
+    job->pool = NULL;
+    if (pg.backend == MC_PROCESOS && procPoolEnabled()) {
+        job->pool = procPoolCreate(maxWorkers);
+        printf("Pool persistente de %d procesos (PROC_POOL=0: un fork por repetición)\n", maxWorkers);
+    }
+    pg.job = job;
+
+    for (int s = 0; s < sweep.nsizes; s++)
+    for (int w = 0; w < sweep.nworkers; w++)
+        runBenchmark(&pg, sweep.sizes[s], usesWorkers ? sweep.workers[w] : 1,
+                     &sweep.cfg, sweep.samplesFile);
+
+    procPoolFree(job->pool);
+    mcTargetFree(job->target);
+    workQueueFree(job->queue);
+    munmap(job, jobBytes);
+    scalingFinish(&pg.scaling, resultsDir);
+    perfCountersClose(&pg.counters);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,46 @@
+#ifndef MC_ENGINE_H
+#define MC_ENGINE_H
+
+#include "mcKernels.h"
+
+/* ==========================================
+ * Motor Monte Carlo con backends intercambiables
+ * ==========================================
+ * Un solo worker (mcKernels.h + workQueue.h) y cuatro formas de lanzarlo:
+ * secuencial (llamada directa), hilos (pthreads), procesos (fork con
+ * memoria compartida) y openmp (región paralela). Todos reparten [0, N)
+ * con la misma cola de bloques y usan el mismo kernel, así que una mejora
+ * en el kernel o el generador acelera a los cuatro por igual y las
+ * comparaciones entre backends miden solo el backend.
+ *
+ *   int main(int argc, char* argv[]) {
+ *       return mcMain("reto2", RESULTS_DIR, "hilos_dartboard", argc, argv);
+ *   }
+ *
+ * Con program == NULL el problema y el backend se eligen al correr:
+ *   montecarlo <dartboard|needles> <backend> <N> [workers]
+ *   montecarlo <dartboard|needles> <backend> --sweep sizes=... threads=...
+ *
+ * El estado que leen los workers (cola, objetivo, slots de resultados) se
+ * crea una vez por programa; el backend procesos corre sobre un pool de
+ * hijos persistente (procPool.h) que atiende todas las repeticiones y
+ * configuraciones del barrido.
+ *
+ * Cada backend sigue escribiendo su CSV histórico (los que leen tablas.py,
+ * graficas.py y perfilado.py), además del CSV unificado, el roofline y el
+ * estudio de escalabilidad.
+ */
+
+typedef enum {
+    MC_SECUENCIAL,
+    MC_HILOS,
+    MC_PROCESOS,
+    MC_OPENMP,
+    MC_BACKENDS
+} McBackend;
+
+/* Ejecuta un programa completo; devuelve el código de salida de main */
+int mcMain(const char* project, const char* resultsDir, const char* program,
+           int argc, char* argv[]);
+
+#endif
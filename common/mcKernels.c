@@ -0,0 +1,374 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "mcKernels.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* ==========================================
+ * Dartboard
+ * ========================================== */
+long dartboardSamples(long n, Rng* rng) {
+    Rng r = *rng;                   // estado en registros durante el bucle
+    long hits = 0;
+    for (long i = 0; i < n; i++) {
+        const double x = rngUniform(&r);
+        const double y = rngUniform(&r);
+        if (x*x + y*y <= 1.0) hits++;
+    }
+    *rng = r;
+    return hits;
+}
+
+typedef double McLanesF __attribute__((vector_size(RNG_LANES * sizeof(double))));
+typedef int64_t McMask __attribute__((vector_size(RNG_LANES * sizeof(int64_t))));
+
+#define DOUBLE_ONE_BITS 0x3FF0000000000000ULL
+
+/* Mitad alta / baja de 32 bits de cada carril como double en [0, 1): los
+ * bits van a la mantisa de un número en [1, 2) y se resta 1 */
+static inline McLanesF unitHi(RngLanes bits) {
+    return (McLanesF)(((bits >> 32) << 20) | DOUBLE_ONE_BITS) - 1.0;
+}
+
+static inline McLanesF unitLo(RngLanes bits) {
+    return (McLanesF)(((bits << 32) >> 12) | DOUBLE_ONE_BITS) - 1.0;
+}
+
+long dartboardSamplesSimd(long n, RngVec* rng) {
+    RngVec r = *rng;
+    McMask acc = { 0 };             // -1 por acierto en cada carril
+    long i = 0;
+    for (; i + RNG_LANES <= n; i += RNG_LANES) {
+        const RngLanes bits = rngVecNext(&r);
+        const McLanesF x = unitHi(bits);
+        const McLanesF y = unitLo(bits);
+        acc += (McMask)(x*x + y*y <= 1.0);
+    }
+    if (i < n) {
+        /* Cola: solo cuentan los primeros n - i carriles */
+        McMask lane;
+        for (int j = 0; j < RNG_LANES; j++) lane[j] = j;
+        const RngLanes bits = rngVecNext(&r);
+        const McLanesF x = unitHi(bits);
+        const McLanesF y = unitLo(bits);
+        acc += (McMask)(x*x + y*y <= 1.0) & (McMask)(lane < n - i);
+    }
+    *rng = r;
+    long hits = 0;
+    for (int j = 0; j < RNG_LANES; j++) hits -= acc[j];
+    return hits;
+}
+
+/* ==========================================
+ * Aguja de Buffon
+ * ========================================== */
+long needlesSamples(long n, Rng* rng, double len, double dist) {
+    const double halfL = len / 2.0;
+    const double halfD = dist / 2.0;
+    Rng r = *rng;
+    long hits = 0;
+    for (long i = 0; i < n; i++) {
+        const double y = rngUniform(&r) * halfD;
+        const double theta = rngUniform(&r) * (M_PI / 2.0);
+        if (y <= halfL * sin(theta)) hits++;
+    }
+    *rng = r;
+    return hits;
+}
+
+/* Una iteración de RNG_LANES agujas candidatas: *ok marca los carriles
+ * aceptados (-1) y el resultado los que además cruzan una línea */
+static inline McMask needleLanes(RngVec* r, double halfD, double halfL2, McMask* ok) {
+    const RngLanes a = rngVecNext(r);
+    const RngLanes b = rngVecNext(r);
+    const McLanesF y = unitHi(a) * halfD;
+    const McLanesF u = unitHi(b);
+    const McLanesF v = unitLo(b);
+    const McLanesF r2 = u*u + v*v;
+    *ok = (McMask)(r2 <= 1.0) & (McMask)(r2 > 0.0);
+    return *ok & (McMask)(y*y * r2 <= halfL2 * v*v);
+}
+
+long needlesSamplesSimd(long n, RngVec* rng, double len, double dist) {
+    const double halfD = dist / 2.0;
+    const double halfL2 = (len / 2.0) * (len / 2.0);
+    RngVec r = *rng;
+    long hits = 0;
+    long remaining = n;
+
+    /* Cada tanda acepta a lo sumo RNG_LANES agujas por iteración, así que
+     * remaining / RNG_LANES iteraciones nunca se pasan de n; queda ~21% de
+     * rechazos por tanda y la cantidad de tandas crece como log(n) */
+    while (remaining >= RNG_LANES) {
+        McMask acc = { 0 };
+        McMask taken = { 0 };
+        for (long b = remaining / RNG_LANES; b > 0; b--) {
+            McMask ok;
+            acc += needleLanes(&r, halfD, halfL2, &ok);
+            taken += ok;
+        }
+        for (int j = 0; j < RNG_LANES; j++) {
+            hits -= acc[j];
+            remaining += taken[j];
+        }
+    }
+    /* Cola: las primeras `remaining` agujas aceptadas, carril por carril */
+    while (remaining > 0) {
+        McMask ok;
+        const McMask hit = needleLanes(&r, halfD, halfL2, &ok);
+        for (int j = 0; j < RNG_LANES && remaining > 0; j++) {
+            if (!ok[j]) continue;
+            remaining--;
+            if (hit[j]) hits++;
+        }
+    }
+    *rng = r;
+    return hits;
+}
+
+/* ==========================================
+ * Contador (reproducible)
+ * ========================================== */
+#define UNIT_32 0x1.0p-32
+
+long dartboardCounter(uint64_t seed, long begin, long end) {
+    long hits = 0;
+    for (long i = begin; i < end; i++) {
+        const uint64_t bits = rngAt(seed, (uint64_t)i);
+        const double x = (double)(uint32_t)(bits >> 32) * UNIT_32;
+        const double y = (double)(uint32_t)bits * UNIT_32;
+        if (x*x + y*y <= 1.0) hits++;
+    }
+    return hits;
+}
+
+long needlesCounter(uint64_t seed, long begin, long end, double len, double dist) {
+    const double halfL = len / 2.0;
+    const double halfD = dist / 2.0;
+    long hits = 0;
+    for (long i = begin; i < end; i++) {
+        const uint64_t bits = rngAt(seed, (uint64_t)i);
+        const double y = (double)(uint32_t)(bits >> 32) * UNIT_32 * halfD;
+        const double theta = (double)(uint32_t)bits * UNIT_32 * (M_PI / 2.0);
+        if (y <= halfL * sin(theta)) hits++;
+    }
+    return hits;
+}
+
+/* ==========================================
+ * Cuasi Monte Carlo
+ * ========================================== */
+#define UNIT_32_HALF 0x1.0p-33      // centro de la celda de 2^-32
+
+static inline int sampleHits(const McProblem* pb, double a, double b) {
+    if (!pb->needles) return a*a + b*b <= 1.0;
+    return a * (pb->dist / 2.0) <= (pb->len / 2.0) * sin(b * (M_PI / 2.0));
+}
+
+long sobolSamples(const Sobol2* s, const McProblem* pb, long begin, long end) {
+    if (begin >= end) return 0;
+    uint32_t x, y;
+    sobolPoint(s, (uint64_t)begin, &x, &y);
+    long hits = 0;
+    for (long i = begin; i < end; i++) {
+        hits += sampleHits(pb, x * UNIT_32 + UNIT_32_HALF, y * UNIT_32 + UNIT_32_HALF);
+        sobolNext(s, (uint64_t)i, &x, &y);
+    }
+    return hits;
+}
+
+long haltonSamples(const Halton2* h, const McProblem* pb, long begin, long end) {
+    Halton3 y;
+    haltonBase3(h, (uint64_t)begin, &y);
+    long hits = 0;
+    for (long i = begin; i < end; i++) {
+        hits += sampleHits(pb, haltonBase2(h, (uint64_t)i) * UNIT_32 + UNIT_32_HALF, y.value * QMC_BASE3_UNIT);
+        haltonNext3(h, &y);
+    }
+    return hits;
+}
+
+/* ==========================================
+ * Reducción de varianza
+ * ========================================== */
+#define MC_STRATA_STEP 2654435769u      // impar: alterna celdas lejanas dentro del barrido
+
+long stratifiedSamples(uint64_t seed, Rng* rng, const McProblem* pb, long begin, long end) {
+    Rng r = *rng;
+    long hits = 0;
+    for (long i = begin; i < end;) {
+        const uint64_t sweep = (uint64_t)i / MC_STRATA;
+        const uint32_t offset = (uint32_t)rngAt(seed, sweep);
+        const long stop = (long)(sweep + 1) * MC_STRATA < end ? (long)(sweep + 1) * MC_STRATA : end;
+        for (; i < stop; i++) {
+            const uint32_t cell = ((uint32_t)i * MC_STRATA_STEP + offset) & (MC_STRATA - 1);
+            const double a = (cell % MC_STRATA_SIDE + rngUniform(&r)) * (1.0 / MC_STRATA_SIDE);
+            const double b = (cell / MC_STRATA_SIDE + rngUniform(&r)) * (1.0 / MC_STRATA_SIDE);
+            hits += sampleHits(pb, a, b);
+        }
+    }
+    *rng = r;
+    return hits;
+}
+
+long antitheticSamples(Rng* rng, const McProblem* pb, long n) {
+    Rng r = *rng;
+    long hits = 0, i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const double a = rngUniform(&r);
+        const double b = rngUniform(&r);
+        hits += sampleHits(pb, a, b) + sampleHits(pb, 1.0 - a, 1.0 - b);
+    }
+    if (i < n) {
+        const double a = rngUniform(&r);
+        hits += sampleHits(pb, a, rngUniform(&r));
+    }
+    *rng = r;
+    return hits;
+}
+
+/* Regiones de control, dentro de las de acierto:
+ *   dartboard: y <= (1 - x²)(1 + x²/2) <= √(1 - x²), área 11/15
+ *   Buffon:    u <= r·v(3 - v²)/2 <= r·sin(πv/2), área 5r/8 (r = len/dist) */
+static inline int controlHits(const McProblem* pb, double a, double b) {
+    if (!pb->needles) {
+        const double t = a * a;
+        return b <= (1.0 - t) * (1.0 + 0.5 * t);
+    }
+    return a * pb->dist <= pb->len * 0.5 * b * (3.0 - b * b);
+}
+
+static double controlMean(const McProblem* pb) {
+    if (!pb->needles) return 11.0 / 15.0;
+    if (pb->len > pb->dist) {
+        fprintf(stderr, "Error: MC_KERNEL=control requiere len <= dist (len=%g, dist=%g)\n", pb->len, pb->dist);
+        exit(EXIT_FAILURE);
+    }
+    return 5.0 * pb->len / (8.0 * pb->dist);
+}
+
+/* Solo la franja. En Buffon el acierto (el único sin de la muestra) se
+ * evalúa solo fuera del control; en dartboard es más barato que el salto
+ * mal predicho */
+long controlSamples(Rng* rng, const McProblem* pb, long n) {
+    Rng r = *rng;
+    long hits = 0;
+    for (long i = 0; i < n; i++) {
+        const double a = rngUniform(&r);
+        const double b = rngUniform(&r);
+        const int inControl = controlHits(pb, a, b);
+        if (!pb->needles) hits += (inControl ^ 1) & sampleHits(pb, a, b);
+        else if (!inControl) hits += sampleHits(pb, a, b);
+    }
+    *rng = r;
+    return hits;
+}
+
+/* ==========================================
+ * Selección de kernel
+ * ========================================== */
+McKernel mcKernelFromEnv(void) {
+    const char* v = getenv("MC_KERNEL");
+    if (v == NULL || *v == '\0' || strcmp(v, "escalar") == 0) return MC_ESCALAR;
+    if (strcmp(v, "simd") == 0) return MC_SIMD;
+    if (strcmp(v, "contador") == 0) return MC_CONTADOR;
+    if (strcmp(v, "sobol") == 0) return MC_SOBOL;
+    if (strcmp(v, "halton") == 0) return MC_HALTON;
+    if (strcmp(v, "estratificado") == 0) return MC_ESTRATIFICADO;
+    if (strcmp(v, "antitetico") == 0) return MC_ANTITETICO;
+    if (strcmp(v, "control") == 0) return MC_CONTROL;
+    fprintf(stderr, "Error: MC_KERNEL=%s inválido (escalar, simd, contador, sobol, halton, "
+            "estratificado, antitetico o control)\n", v);
+    exit(EXIT_FAILURE);
+}
+
+const char* mcKernelName(McKernel kernel) {
+    switch (kernel) {
+    case MC_SIMD: return "simd";
+    case MC_CONTADOR: return "contador";
+    case MC_SOBOL: return "sobol";
+    case MC_HALTON: return "halton";
+    case MC_ESTRATIFICADO: return "estratificado";
+    case MC_ANTITETICO: return "antitetico";
+    case MC_CONTROL: return "control";
+    default: return "escalar";
+    }
+}
+
+/* MC_RQMC=0: secuencias QMC sin aleatorizar */
+static int qmcRandomized(void) {
+    const char* v = getenv("MC_RQMC");
+    return v == NULL || strcmp(v, "0") != 0;
+}
+
+void mcVariantName(char* out, size_t size, const char* base, McKernel kernel) {
+    if (kernel == MC_ESCALAR) snprintf(out, size, "%s", base);
+    else snprintf(out, size, "%s_%s", base, mcKernelName(kernel));
+}
+
+void mcStreamInit(McStream* st, McKernel kernel, uint64_t seed, int id) {
+    st->kernel = kernel;
+    st->seed = seed;
+    /* QMC: todos los workers comparten la secuencia (y su aleatorización) */
+    if (kernel == MC_SIMD) rngVecStream(&st->lanes, seed, id);
+    else if (kernel == MC_SOBOL) sobolInit(&st->sobol, seed, qmcRandomized());
+    else if (kernel == MC_HALTON) haltonInit(&st->halton, seed, qmcRandomized());
+    else if (kernel != MC_CONTADOR) rngStream(&st->rng, seed, id);
+}
+
+long dartboardRun(McStream* st, long begin, long end) {
+    static const McProblem dartboard = { 0, 0.0, 0.0 };
+    switch (st->kernel) {
+    case MC_SIMD: return dartboardSamplesSimd(end - begin, &st->lanes);
+    case MC_CONTADOR: return dartboardCounter(st->seed, begin, end);
+    case MC_SOBOL: return sobolSamples(&st->sobol, &dartboard, begin, end);
+    case MC_HALTON: return haltonSamples(&st->halton, &dartboard, begin, end);
+    case MC_ESTRATIFICADO: return stratifiedSamples(st->seed, &st->rng, &dartboard, begin, end);
+    case MC_ANTITETICO: return antitheticSamples(&st->rng, &dartboard, end - begin);
+    case MC_CONTROL: return controlSamples(&st->rng, &dartboard, end - begin);
+    default: return dartboardSamples(end - begin, &st->rng);
+    }
+}
+
+long needlesRun(McStream* st, long begin, long end, double len, double dist) {
+    const McProblem needles = { 1, len, dist };
+    switch (st->kernel) {
+    case MC_SIMD: return needlesSamplesSimd(end - begin, &st->lanes, len, dist);
+    case MC_CONTADOR: return needlesCounter(st->seed, begin, end, len, dist);
+    case MC_SOBOL: return sobolSamples(&st->sobol, &needles, begin, end);
+    case MC_HALTON: return haltonSamples(&st->halton, &needles, begin, end);
+    case MC_ESTRATIFICADO: return stratifiedSamples(st->seed, &st->rng, &needles, begin, end);
+    case MC_ANTITETICO: return antitheticSamples(&st->rng, &needles, end - begin);
+    case MC_CONTROL: return controlSamples(&st->rng, &needles, end - begin);
+    default: return needlesSamples(end - begin, &st->rng, len, dist);
+    }
+}
+
+long mcRun(McStream* st, const McProblem* pb, long begin, long end) {
+    return pb->needles ? needlesRun(st, begin, end, pb->len, pb->dist) : dartboardRun(st, begin, end);
+}
+
+double mcPiFromRatio(const McProblem* pb, double p) {
+    if (!pb->needles) return 4.0 * p;
+    return p > 0.0 ? 2.0 * pb->len / (pb->dist * p) : 0.0;
+}
+
+double mcRatioOffset(const McProblem* pb, McKernel kernel) {
+    return kernel == MC_CONTROL ? controlMean(pb) : 0.0;
+}
+
+double mcPiFromHits(const McProblem* pb, McKernel kernel, long hits, long n) {
+    if (n <= 0) return 0.0;
+    return mcPiFromRatio(pb, mcRatioOffset(pb, kernel) + (double)hits / n);
+}
+
+void mcPrintThroughput(McKernel kernel, long N, int workers, double seconds) {
+    if (seconds <= 0.0) return;
+    printf("Kernel %s: %.2f Mmuestras/s por worker (%.2f en total)\n",
+           mcKernelName(kernel), N / seconds / workers / 1e6, N / seconds / 1e6);
+}
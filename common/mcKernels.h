@@ -0,0 +1,152 @@
+#ifndef MC_KERNELS_H
+#define MC_KERNELS_H
+
+#include <stddef.h>
+
+#include "rng.h"
+#include "qmc.h"
+
+/* ==========================================
+ * Kernels Monte Carlo (reto1 y reto2)
+ * ==========================================
+ * El bucle de muestras, compartido por todos los backends de mcEngine.h y
+ * separado del programa para que reto2/src/microbench mida exactamente el
+ * mismo código (con -flto se sigue inlineando en cada binario). Cada worker
+ * pasa su propio flujo de xoshiro256++ (rngStream con su id, rng.h),
+ * inicializado una sola vez al empezar la región paralela. Ambos devuelven
+ * la cantidad de aciertos.
+ *
+ * Dartboard: puntos (x, y) en [0,1)² dentro del cuarto de círculo.
+ * Buffon: aguja de largo `len` sobre líneas separadas `dist` (len <= dist);
+ * distancia del centro a la línea más cercana en [0, dist/2), ángulo en
+ * [0, π/2). P(cruce) = 2·len / (π·dist).
+ */
+/* Problema a estimar: con él, el código que no depende de cuál es (los
+ * kernels QMC, el modo de precisión objetivo de mcTarget.h) es uno solo */
+typedef struct {
+    int needles;            // 0: dartboard (π = 4p); 1: Buffon (π = 2·len / (dist·p))
+    double len;
+    double dist;
+} McProblem;
+
+/* Geometría común de las cuatro implementaciones (necesaria para que el
+ * modo contador dé el mismo resultado en todas) */
+#define MC_NEEDLE_LEN 1.0
+#define MC_NEEDLE_DIST 1.0
+
+long dartboardSamples(long n, Rng* rng);
+long needlesSamples(long n, Rng* rng, double len, double dist);
+
+/* RNG_LANES muestras por iteración: x e y salen de las dos mitades de 32
+ * bits de cada salida, armadas como double en [1, 2) sin conversión
+ * entera, y los aciertos se acumulan con la máscara de la comparación */
+long dartboardSamplesSimd(long n, RngVec* rng);
+
+/* Sin trigonometría: la dirección es (u, v) uniforme en [0,1)² aceptada
+ * si cae en el cuarto de círculo (π/4 de los casos), con lo que el ángulo
+ * es uniforme en [0, π/2) y sin θ = v / |(u, v)|. El cruce y <= (len/2)·sin θ
+ * se evalúa al cuadrado, sin raíz ni división. Devuelve los aciertos entre
+ * exactamente n agujas aceptadas (las rechazadas no cuentan). */
+long needlesSamplesSimd(long n, RngVec* rng, double len, double dist);
+
+/* Contador: la muestra i usa rngAt(seed, i) (x/y o distancia/ángulo de
+ * sus dos mitades de 32 bits), así que los aciertos de [begin, end) no
+ * dependen de cómo se reparta el rango. Sumar los de cualquier partición
+ * de [0, N) da siempre el mismo total, bit a bit. */
+long dartboardCounter(uint64_t seed, long begin, long end);
+long needlesCounter(uint64_t seed, long begin, long end, double len, double dist);
+
+/* Cuasi Monte Carlo (qmc.h): la muestra i es el punto i de la secuencia,
+ * (x, y) para dartboard y (distancia, ángulo) para Buffon. El reparto por
+ * rangos es un salto directo al primer índice de cada worker. */
+long sobolSamples(const Sobol2* s, const McProblem* pb, long begin, long end);
+long haltonSamples(const Halton2* h, const McProblem* pb, long begin, long end);
+
+/* Reducción de varianza sobre xoshiro256++ escalar, en el dominio (x, y)
+ * o (distancia, ángulo) normalizado a [0,1)²:
+ *
+ * Estratificado: rejilla de MC_STRATA_SIDE² celdas con una muestra por
+ * celda en cada barrido de MC_STRATA índices consecutivos. El orden de las
+ * celdas dentro del barrido se desplaza al azar (rngAt(seed, barrido)), así
+ * que un barrido incompleto (el borde del rango de un worker o de N) sigue
+ * siendo insesgado. Cada worker se queda con los barridos de su rango: sus
+ * estratos no los toca nadie más.
+ *
+ * Antitético: pares (u, v) y (1-u, 1-v). Ambos aciertos son monótonos en
+ * cada coordenada, así que el par está correlacionado negativamente.
+ *
+ * Control: una región contenida en la de acierto y de área conocida sin π
+ * (frontera polinómica); se cuentan solo las muestras en la franja entre
+ * ambas y p = área de control + franja / n (mcRatioOffset). Es la variable
+ * de control 1{control} con β = 1, casi óptimo porque las regiones se
+ * solapan casi por completo. En Buffon exige len <= dist. */
+#define MC_STRATA_SIDE 64
+#define MC_STRATA (MC_STRATA_SIDE * MC_STRATA_SIDE)
+
+long stratifiedSamples(uint64_t seed, Rng* rng, const McProblem* pb, long begin, long end);
+long antitheticSamples(Rng* rng, const McProblem* pb, long n);
+long controlSamples(Rng* rng, const McProblem* pb, long n);
+
+/* ==========================================
+ * Selección de kernel
+ * ==========================================
+ * MC_KERNEL=escalar (por defecto), simd, contador, sobol, halton,
+ * estratificado, antitetico o control elige el bucle en todas las
+ * implementaciones. Cada worker arma su McStream con su id y
+ * llama a dartboardRun/needlesRun con el rango de muestras que le toca;
+ * el kernel queda en la variante del registro unificado (dartboard_simd,
+ * needles_contador...) para compararlo con el escalar.
+ *
+ * Con contador el resultado es reproducible: misma semilla (RNG_SEED) y
+ * mismo N dan los mismos aciertos con cualquier implementación y cantidad
+ * de workers, así que los experimentos de speedup y las regresiones
+ * pueden exigir igualdad exacta del π estimado.
+ *
+ * sobol y halton también dan el mismo resultado con cualquier reparto.
+ * Por defecto se aleatorizan con la semilla (RQMC: réplicas
+ * independientes, error estimable); MC_RQMC=0 usa la secuencia fija. El
+ * IC de Wilson de MC_TOL supone muestras independientes, así que con QMC,
+ * estratificado y antitetico es conservador; con control es exacto (la
+ * franja es una proporción binomial). scripts/varianza.py mide el factor de
+ * reducción de varianza y el tiempo hasta la precisión contra escalar.
+ */
+typedef enum {
+    MC_ESCALAR,
+    MC_SIMD,
+    MC_CONTADOR,
+    MC_SOBOL,
+    MC_HALTON,
+    MC_ESTRATIFICADO,
+    MC_ANTITETICO,
+    MC_CONTROL
+} McKernel;
+
+typedef struct {
+    McKernel kernel;
+    uint64_t seed;          // MC_CONTADOR
+    Rng rng;                // MC_ESCALAR y los de reducción de varianza
+    RngVec lanes;           // MC_SIMD
+    Sobol2 sobol;           // MC_SOBOL
+    Halton2 halton;         // MC_HALTON
+} McStream;
+
+McKernel mcKernelFromEnv(void);
+const char* mcKernelName(McKernel kernel);
+/* base ("dartboard", "hilos_needles"...) con el sufijo del kernel, salvo escalar */
+void mcVariantName(char* out, size_t size, const char* base, McKernel kernel);
+void mcStreamInit(McStream* st, McKernel kernel, uint64_t seed, int id);
+/* Muestras [begin, end) del total; los kernels con flujo solo usan end - begin */
+long dartboardRun(McStream* st, long begin, long end);
+long needlesRun(McStream* st, long begin, long end, double len, double dist);
+long mcRun(McStream* st, const McProblem* pb, long begin, long end);
+/* π a partir de la proporción de aciertos p (0 si p no permite estimarlo) */
+double mcPiFromRatio(const McProblem* pb, double p);
+/* Lo que el kernel no cuenta en hits/n: el área de control con MC_CONTROL, 0 si no */
+double mcRatioOffset(const McProblem* pb, McKernel kernel);
+/* π a partir de los aciertos de n muestras del kernel */
+double mcPiFromHits(const McProblem* pb, McKernel kernel, long hits, long n);
+
+/* Muestras por segundo y por worker, junto al kernel usado */
+void mcPrintThroughput(McKernel kernel, long N, int workers, double seconds);
+
+#endif
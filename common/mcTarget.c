@@ -0,0 +1,145 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <sys/mman.h>
+
+#include "mcTarget.h"
+#include "csvUtils.h"
+#include "machineInfo.h"
+
+/* ==========================================
+ * Intervalo de Wilson
+ * ========================================== */
+/* IC de π a partir de hits/n: Wilson para la proporción, el desplazamiento
+ * del kernel y luego la transformación monótona del problema (decreciente
+ * para Buffon) */
+static double piInterval(const McProblem* pb, double offset, long hits, long n, double* lo, double* hi) {
+    if (n <= 0) {
+        if (lo) *lo = 0.0;
+        if (hi) *hi = 0.0;
+        return 0.0;
+    }
+    const double z2 = MC_TARGET_Z * MC_TARGET_Z;
+    const double p = (double)hits / n;
+    const double denom = 1.0 + z2 / n;
+    const double center = (p + z2 / (2.0 * n)) / denom;
+    const double half = MC_TARGET_Z * sqrt(p * (1.0 - p) / n + z2 / (4.0 * n * (double)n)) / denom;
+    const double a = mcPiFromRatio(pb, offset + center - half);
+    const double b = mcPiFromRatio(pb, offset + center + half);
+    if (lo) *lo = a < b ? a : b;
+    if (hi) *hi = a < b ? b : a;
+    return mcPiFromRatio(pb, offset + p);
+}
+
+static double relHalfWidth(const McTarget* t, long hits, long n) {
+    double lo, hi;
+    const double pi = piInterval(&t->problem, t->offset, hits, n, &lo, &hi);
+    return pi > 0.0 ? 0.5 * (hi - lo) / pi : 1.0;
+}
+
+/* ==========================================
+ * Acumulador
+ * ========================================== */
+static double envDouble(const char* name, double def) {
+    const char* v = getenv(name);
+    if (v == NULL || *v == '\0') return def;
+    char* end;
+    double x = strtod(v, &end);
+    if (end == v || *end != '\0' || x <= 0.0) {
+        fprintf(stderr, "Error: %s=%s inválido (se espera un número positivo)\n", name, v);
+        exit(EXIT_FAILURE);
+    }
+    return x;
+}
+
+McTarget* mcTargetFromEnv(const McProblem* pb, McKernel kernel, long maxSamples) {
+    if (getenv("MC_TOL") == NULL) return NULL;
+    const double tol = envDouble("MC_TOL", 0.0);
+    if (tol >= 1.0) {
+        fprintf(stderr, "Error: MC_TOL=%g inválido (semiancho relativo, entre 0 y 1)\n", tol);
+        exit(EXIT_FAILURE);
+    }
+
+    McTarget* t = mmap(NULL, sizeof(McTarget), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (t == MAP_FAILED) {
+        perror("mmap");
+        exit(EXIT_FAILURE);
+    }
+    t->problem = *pb;
+    t->offset = mcRatioOffset(pb, kernel);
+    t->tol = tol;
+    t->batch = (long)envDouble("MC_BATCH", (double)MC_TARGET_BATCH);
+    if (t->batch < 1) t->batch = 1;
+    mcTargetReset(t, maxSamples);
+    return t;
+}
+
+void mcTargetReset(McTarget* t, long maxSamples) {
+    t->maxSamples = maxSamples;
+    t->samples = 0;
+    t->hits = 0;
+    t->done = 0;
+    t->timeToTarget = -1.0;
+    t->t0 = benchNow();
+}
+
+int mcTargetWork(McTarget* t, McStream* st, long begin, long end) {
+    for (long b = begin; b < end; b += t->batch) {
+        if (__atomic_load_n(&t->done, __ATOMIC_RELAXED)) return 0;
+        const long e = b + t->batch < end ? b + t->batch : end;
+        const long h = mcRun(st, &t->problem, b, e);
+        const long hits = __atomic_add_fetch(&t->hits, h, __ATOMIC_RELAXED);
+        const long n = __atomic_add_fetch(&t->samples, e - b, __ATOMIC_RELAXED);
+
+        /* hits y n pueden mezclar lotes de otros workers en vuelo: solo
+         * deciden cuándo parar, el IC final se calcula sobre los totales */
+        if (relHalfWidth(t, hits, n) <= t->tol) {
+            int expected = 0;
+            if (__atomic_compare_exchange_n(&t->done, &expected, 1, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                t->timeToTarget = benchNow() - t->t0;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+double mcTargetPi(const McTarget* t, double* lo, double* hi) {
+    return piInterval(&t->problem, t->offset, t->hits, t->samples, lo, hi);
+}
+
+/* ==========================================
+ * Reporte
+ * ========================================== */
+void mcTargetReport(const McTarget* t, const char* dirPath, const BenchRecord* rec, const BenchRun* run) {
+    double lo, hi;
+    const double pi = mcTargetPi(t, &lo, &hi);
+    const double rel = pi > 0.0 ? 0.5 * (hi - lo) / pi : 0.0;
+    const int reached = t->timeToTarget >= 0.0;
+
+    printf("Precisión objetivo ±%.2e: %s con %ld de %ld muestras (%.1f%%)\n", t->tol,
+           reached ? "alcanzada" : "NO alcanzada", t->samples, t->maxSamples,
+           100.0 * t->samples / t->maxSamples);
+    printf("IC 95%% de π: [%.9f, %.9f] (±%.2e)", lo, hi, rel);
+    if (reached) printf(", en %.6f s", t->timeToTarget);
+    printf("\n");
+
+    benchEnsureDir(dirPath);
+    char filename[512];
+    snprintf(filename, sizeof(filename), "%s/Precision_Results.csv", dirPath);
+    ensureCSVHeader(filename, MC_TARGET_CSV_HEADER);
+    FILE* f = fopen(filename, "a");
+    if (f == NULL) {
+        fprintf(stderr, "Error: no se pudo abrir %s\n", filename);
+        return;
+    }
+    fprintf(f, "%s,%s,%s,%ld,%d,%g,%ld,%ld,%ld,%.9f,%.9f,%.9f,%.3e,%d,", rec->project, rec->program,
+            rec->variant, t->maxSamples, rec->workers, t->tol, t->batch, t->samples, t->hits,
+            pi, lo, hi, rel, reached);
+    if (reached) fprintf(f, "%.9f", t->timeToTarget);
+    fprintf(f, ",%.9f,%s\n", run->summary.median, machineInfoGet()->machine_id);
+    fclose(f);
+}
+
+void mcTargetFree(McTarget* t) {
+    if (t != NULL) munmap(t, sizeof(McTarget));
+}
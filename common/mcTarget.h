@@ -0,0 +1,63 @@
+#ifndef MC_TARGET_H
+#define MC_TARGET_H
+
+#include "hpcbench.h"
+#include "mcKernels.h"
+
+/* ==========================================
+ * Precisión objetivo: parar al alcanzar el IC pedido
+ * ==========================================
+ * Con MC_TOL=t (semiancho relativo del IC 95% de π, p. ej. 1e-4) N deja de
+ * ser la cantidad de muestras y pasa a ser el tope. Cada worker recorre su
+ * rango en lotes de MC_BATCH muestras (por defecto 2^16) y suma aciertos y
+ * muestras del lote al acumulador común; el worker que cierra un lote
+ * recalcula el intervalo de Wilson sobre el total y, si ya alcanza la
+ * tolerancia, marca el fin y todos los workers cortan en su próximo lote.
+ *
+ *   McTarget* target = mcTargetFromEnv(&problem, kernel, N);   // NULL sin MC_TOL
+ *   while (benchRunNext(&run)) {
+ *       if (target) mcTargetReset(target, N);           // antes de lanzar
+ *       ...worker: if (target) mcTargetWork(target, &stream, begin, end);
+ *                  else hits = mcRun(&stream, &problem, begin, end);
+ *   }
+ *   if (target) { pi = mcTargetPi(target, NULL, NULL); mcTargetReport(target, dir, &record, &run); }
+ *
+ * El acumulador vive en memoria compartida (mmap), así que sirve igual
+ * para hilos, procesos (fork) y OpenMP. El reporte y Precision_Results.csv
+ * son de la última repetición: muestras usadas, IC final y el tiempo hasta
+ * alcanzar la precisión (desde mcTargetReset hasta que un worker la detecta).
+ * Con MC_KERNEL=control los aciertos son los de la franja y el intervalo se
+ * desplaza por el área de control (mcRatioOffset).
+ */
+#define MC_TARGET_Z 1.96
+#define MC_TARGET_BATCH (1L << 16)
+
+typedef struct {
+    McProblem problem;
+    double offset;          // mcRatioOffset del kernel
+    double tol;
+    long batch;
+    long maxSamples;
+    long samples;           // acumulados de la repetición (atómicos)
+    long hits;
+    int done;
+    double t0;
+    double timeToTarget;    // -1 si no se alcanzó la tolerancia
+} McTarget;
+
+McTarget* mcTargetFromEnv(const McProblem* pb, McKernel kernel, long maxSamples);
+/* N puede cambiar entre configuraciones: el mismo acumulador sirve a todo un barrido */
+void mcTargetReset(McTarget* t, long maxSamples);
+/* [begin, end) en lotes, publicando cada uno; vuelve antes si otro worker
+ * terminó. Devuelve 0 si ya se alcanzó la precisión (no hace falta más) */
+int mcTargetWork(McTarget* t, McStream* st, long begin, long end);
+/* π estimado con las muestras acumuladas y, si se piden, los extremos del IC */
+double mcTargetPi(const McTarget* t, double* lo, double* hi);
+void mcTargetReport(const McTarget* t, const char* dirPath, const BenchRecord* rec, const BenchRun* run);
+void mcTargetFree(McTarget* t);
+
+#define MC_TARGET_CSV_HEADER \
+    "project,program,variant,max_samples,workers,tol,batch,samples,hits,pi_est,ci_lo,ci_hi,ci_rel," \
+    "reached,time_to_precision_s,median_s,machine_id"
+
+#endif
@@ -0,0 +1,214 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <malloc.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include "memTrack.h"
+#include "csvUtils.h"
+#include "machineInfo.h"
+
+#define MEM_MAX_PHASES 16
+
+/* Asignador real de glibc (exportado para quien envuelve malloc) */
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t n, size_t size);
+extern void* __libc_realloc(void* p, size_t size);
+extern void* __libc_memalign(size_t alignment, size_t size);
+extern void __libc_free(void* p);
+
+typedef struct {
+    const char* name;
+    long allocs0;           // contadores globales al abrir la fase
+    long frees0;
+    long bytes0;
+    long allocs;            // valores de la fase al cerrarla
+    long frees;
+    long bytes;
+    long peak;
+    long liveEnd;
+} MemPhase;
+
+/* Contadores globales: se actualizan desde cualquier hilo sin locks */
+static long allocCount = 0;
+static long freeCount = 0;
+static long allocBytes = 0;
+static long liveBytes = 0;
+static long peakBytes = 0;
+static long phasePeakBytes = 0;
+
+static MemPhase phases[MEM_MAX_PHASES];
+static int nphases = 0;
+
+/* ==========================================
+ * Contabilidad
+ * ========================================== */
+static inline void raiseMax(long* target, long value) {
+    long cur = __atomic_load_n(target, __ATOMIC_RELAXED);
+    while (value > cur &&
+           !__atomic_compare_exchange_n(target, &cur, value, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+}
+
+static inline void noteAlloc(size_t size) {
+    __atomic_add_fetch(&allocCount, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&allocBytes, (long)size, __ATOMIC_RELAXED);
+    long live = __atomic_add_fetch(&liveBytes, (long)size, __ATOMIC_RELAXED);
+    raiseMax(&peakBytes, live);
+    raiseMax(&phasePeakBytes, live);
+}
+
+static inline void noteFree(size_t size) {
+    __atomic_add_fetch(&freeCount, 1, __ATOMIC_RELAXED);
+    __atomic_sub_fetch(&liveBytes, (long)size, __ATOMIC_RELAXED);
+}
+
+long memTrackAllocCount(void) { return __atomic_load_n(&allocCount, __ATOMIC_RELAXED); }
+long memTrackLiveBytes(void) { return __atomic_load_n(&liveBytes, __ATOMIC_RELAXED); }
+long memTrackPeakBytes(void) { return __atomic_load_n(&peakBytes, __ATOMIC_RELAXED); }
+
+/* ==========================================
+ * Envoltorios (reemplazan los símbolos de libc en el binario)
+ * ========================================== */
+void* malloc(size_t size) {
+    void* p = __libc_malloc(size);
+    if (p != NULL) noteAlloc(malloc_usable_size(p));
+    return p;
+}
+
+void* calloc(size_t n, size_t size) {
+    void* p = __libc_calloc(n, size);
+    if (p != NULL) noteAlloc(malloc_usable_size(p));
+    return p;
+}
+
+void* realloc(void* old, size_t size) {
+    size_t oldSize = old != NULL ? malloc_usable_size(old) : 0;
+    void* p = __libc_realloc(old, size);
+    if (p != NULL) {
+        if (old != NULL) noteFree(oldSize);
+        noteAlloc(malloc_usable_size(p));
+    } else if (old != NULL && size == 0) {
+        noteFree(oldSize);          // realloc(p, 0) libera
+    }
+    return p;
+}
+
+void* reallocarray(void* old, size_t n, size_t size) {
+    size_t total;
+    if (__builtin_mul_overflow(n, size, &total)) {
+        errno = ENOMEM;
+        return NULL;
+    }
+    return realloc(old, total);
+}
+
+void free(void* p) {
+    if (p == NULL) return;
+    noteFree(malloc_usable_size(p));
+    __libc_free(p);
+}
+
+void* memalign(size_t alignment, size_t size) {
+    void* p = __libc_memalign(alignment, size);
+    if (p != NULL) noteAlloc(malloc_usable_size(p));
+    return p;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    return memalign(alignment, size);
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) {
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0) return EINVAL;
+    void* p = memalign(alignment, size);
+    if (p == NULL) return ENOMEM;
+    *out = p;
+    return 0;
+}
+
+void* valloc(size_t size) {
+    return memalign(sysconf(_SC_PAGESIZE), size);
+}
+
+void* pvalloc(size_t size) {
+    size_t page = sysconf(_SC_PAGESIZE);
+    return memalign(page, (size + page - 1) & ~(page - 1));
+}
+
+/* mmap/munmap por syscall directa: glibc no exporta su versión interna */
+void* mmap(void* addr, size_t length, int prot, int flags, int fd, off_t offset) {
+    void* p = (void*)syscall(SYS_mmap, addr, length, prot, flags, fd, offset);
+    if (p != MAP_FAILED) noteAlloc(length);
+    return p;
+}
+
+int munmap(void* addr, size_t length) {
+    int r = (int)syscall(SYS_munmap, addr, length);
+    if (r == 0) noteFree(length);
+    return r;
+}
+
+/* ==========================================
+ * Fases
+ * ========================================== */
+static void closePhase(void) {
+    if (nphases == 0) return;
+    MemPhase* ph = &phases[nphases - 1];
+    ph->allocs = memTrackAllocCount() - ph->allocs0;
+    ph->frees = __atomic_load_n(&freeCount, __ATOMIC_RELAXED) - ph->frees0;
+    ph->bytes = __atomic_load_n(&allocBytes, __ATOMIC_RELAXED) - ph->bytes0;
+    ph->peak = __atomic_load_n(&phasePeakBytes, __ATOMIC_RELAXED);
+    ph->liveEnd = memTrackLiveBytes();
+}
+
+void memTrackPhase(const char* name) {
+    closePhase();
+    if (nphases == MEM_MAX_PHASES) {
+        fprintf(stderr, "Error: más de %d fases de memoria\n", MEM_MAX_PHASES);
+        exit(EXIT_FAILURE);
+    }
+    MemPhase* ph = &phases[nphases++];
+    memset(ph, 0, sizeof(*ph));
+    ph->name = name;
+    ph->allocs0 = memTrackAllocCount();
+    ph->frees0 = __atomic_load_n(&freeCount, __ATOMIC_RELAXED);
+    ph->bytes0 = __atomic_load_n(&allocBytes, __ATOMIC_RELAXED);
+    __atomic_store_n(&phasePeakBytes, memTrackLiveBytes(), __ATOMIC_RELAXED);
+}
+
+void memTrackReport(const char* dirPath, const BenchRecord* rec) {
+    closePhase();
+    const double MB = 1024.0 * 1024.0;
+
+    printf("\n===== MEMORIA POR FASE =====\n");
+    printf("%-14s %10s %10s %12s %12s %12s\n", "fase", "asign.", "liberac.", "asignado MB", "pico MB", "vivo MB");
+    for (int i = 0; i < nphases; i++) {
+        const MemPhase* ph = &phases[i];
+        printf("%-14s %10ld %10ld %12.3f %12.3f %12.3f\n", ph->name, ph->allocs, ph->frees,
+               ph->bytes / MB, ph->peak / MB, ph->liveEnd / MB);
+    }
+    printf("Pico total: %.3f MB\n", memTrackPeakBytes() / MB);
+
+    benchEnsureDir(dirPath);
+    char filename[512];
+    snprintf(filename, sizeof(filename), "%s/Memory_Phases.csv", dirPath);
+    ensureCSVHeader(filename, MEM_PHASES_CSV_HEADER);
+    FILE* f = fopen(filename, "a");
+    if (f == NULL) {
+        fprintf(stderr, "Error: no se pudo abrir %s\n", filename);
+        return;
+    }
+    const char* machineId = machineInfoGet()->machine_id;
+    for (int i = 0; i < nphases; i++) {
+        const MemPhase* ph = &phases[i];
+        fprintf(f, "%s,%s,%s,%ld,%d,%s,%ld,%ld,%.3f,%.3f,%.3f,%s\n",
+                rec->project, rec->program, rec->variant ? rec->variant : rec->program,
+                rec->size, rec->workers, ph->name, ph->allocs, ph->frees,
+                ph->bytes / MB, ph->peak / MB, ph->liveEnd / MB, machineId);
+    }
+    fclose(f);
+}
@@ -0,0 +1,36 @@
+#ifndef MEM_TRACK_H
+#define MEM_TRACK_H
+
+#include "hpcbench.h"
+
+/* ==========================================
+ * Rastreo de memoria dinámica por fase
+ * ==========================================
+ * Basta con enlazar memTrack.c: reemplaza malloc, calloc, realloc, free
+ * (y las variantes alineadas) y mmap/munmap del binario por envoltorios
+ * que cuentan asignaciones y bytes vivos y luego delegan en glibc. Las
+ * llamadas internas de las bibliotecas que pasan por esos símbolos
+ * (libgomp, MPI, stdio) también cuentan; las pilas de los hilos y la
+ * memoria compartida de System V (shmget) no.
+ *
+ *   memTrackPhase("generacion");     // cierra la fase anterior y abre otra
+ *   ...crear matrices...
+ *   memTrackPhase("calculo");
+ *   ...
+ *   memTrackReport(dir, &record);    // Memory_Phases.csv + tabla
+ *
+ * hpcbench cuenta además las asignaciones dentro de cada región medida
+ * (columna timed_allocs de Bench_Results.csv); con BENCH_NO_ALLOC=1 una
+ * asignación ahí termina el programa con error.
+ */
+long memTrackAllocCount(void);      // asignaciones desde el inicio del proceso
+long memTrackLiveBytes(void);
+long memTrackPeakBytes(void);
+
+void memTrackPhase(const char* name);
+void memTrackReport(const char* dirPath, const BenchRecord* rec);
+
+#define MEM_PHASES_CSV_HEADER \
+    "project,program,variant,size,workers,phase,allocs,frees,alloc_mb,peak_live_mb,live_end_mb,machine_id"
+
+#endif
@@ -0,0 +1,208 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "microbench.h"
+#include "csvUtils.h"
+#include "machineInfo.h"
+
+#define MICRO_MAX_CALLS (1L << 30)
+
+/* ==========================================
+ * Reloj de ciclos de referencia
+ * ========================================== */
+/* Frecuencia del TSC medida contra CLOCK_MONOTONIC_RAW durante ~20 ms */
+static double calibrateTsc(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    double t0 = benchNow();
+    unsigned long long c0 = __rdtsc();
+    while (benchNow() - t0 < 0.02)
+        ;
+    double t1 = benchNow();
+    unsigned long long c1 = __rdtsc();
+    return (c1 - c0) / (t1 - t0);
+#else
+    return 0.0;
+#endif
+}
+
+/* ==========================================
+ * Suite
+ * ========================================== */
+void microInit(MicroSuite* s, const char* project, BenchSweep* grid, int argc, char* argv[]) {
+    memset(s, 0, sizeof(*s));
+    s->project = project;
+
+    /* Por defecto repeticiones adaptativas */
+    BenchConfig cfg;
+    benchConfigInit(&cfg);
+    if (cfg.targetCI == 0.0 && cfg.reps == BENCH_REPS_UNSET) cfg.targetCI = 0.02;
+    benchSweepInit(grid, &cfg);
+    grid->nworkers = 0;
+
+    for (int a = 1; a < argc; a++) {
+        if (strncmp(argv[a], "filter=", 7) == 0) {
+            s->filter = argv[a] + 7;
+            continue;
+        }
+        if (!benchSweepArg(grid, argv[a])) {
+            fprintf(stderr, "Error: opción no reconocida: %s\n"
+                            "Uso: %s [sizes=a,b,...] [threads=a,b,...] [filter=texto] "
+                            "[reps=R] [warmup=W] [ci=0.02] [minreps=M]\n",
+                    argv[a], argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    s->cfg = grid->cfg;
+
+    perfCountersOpen(&s->counters);
+    if (s->counters.fd[PERF_CYCLES] < 0) s->tscHz = calibrateTsc();
+}
+
+int microWants(const MicroSuite* s, const char* variant) {
+    return s->filter == NULL || strstr(variant, s->filter) != NULL;
+}
+
+/* Llamadas por muestra: se duplican hasta pasar MICRO_MIN_SAMPLE_S (de paso
+ * calienta cachés y predictores) */
+static long calibrateCalls(MicroKernelFn fn, void* ctx) {
+    long calls = 1;
+    while (calls < MICRO_MAX_CALLS) {
+        double t0 = benchNow();
+        for (long i = 0; i < calls; i++) fn(ctx);
+        if (benchNow() - t0 >= MICRO_MIN_SAMPLE_S) break;
+        calls *= 2;
+    }
+    return calls;
+}
+
+void microRun(MicroSuite* s, const MicroCase* c, MicroKernelFn fn, void* ctx) {
+    if (!microWants(s, c->variant)) return;
+
+    if (s->count == s->capacity) {
+        s->capacity = s->capacity ? 2 * s->capacity : 32;
+        s->results = (MicroResult*)realloc(s->results, s->capacity * sizeof(MicroResult));
+        if (s->results == NULL) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para los microbenchmarks\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    MicroResult* r = &s->results[s->count++];
+    memset(r, 0, sizeof(*r));
+    r->c = *c;
+    r->calls = calibrateCalls(fn, ctx);
+
+    double cycles = 0.0;
+    int cycleSamples = 0;
+    BenchRun run;
+    benchRunInit(&run, &s->cfg);
+    while (benchRunNext(&run)) {
+        perfCountersStart(&s->counters);
+        benchStart(&run);
+
+        for (long i = 0; i < r->calls; i++) fn(ctx);
+
+        benchStop(&run);
+        perfCountersStop(&s->counters);
+        if (!benchIsWarmup(&run) && s->counters.value[PERF_CYCLES] >= 0) {
+            cycles += (double)s->counters.value[PERF_CYCLES];
+            cycleSamples++;
+        }
+    }
+    benchRunFinish(&run);
+    r->summary = run.summary;
+    r->secondsPerCall = run.summary.median / r->calls;
+    benchRunFree(&run);
+
+    if (cycleSamples > 0) {
+        r->cyclesPerCall = cycles / cycleSamples / r->calls;
+        r->pmuCycles = 1;
+    } else {
+        r->cyclesPerCall = s->tscHz > 0.0 ? r->secondsPerCall * s->tscHz : -1.0;
+    }
+
+    printf("  %-10s %-16s N=%-9ld p=%-3d %12.3f ns/llamada (%ld llamadas x %d muestras)\n",
+           c->group, c->variant, c->size, c->workers, 1e9 * r->secondsPerCall, r->calls, r->summary.n);
+    fflush(stdout);
+}
+
+/* ==========================================
+ * Reporte
+ * ========================================== */
+static int sameBlock(const MicroCase* a, const MicroCase* b) {
+    return strcmp(a->group, b->group) == 0 && a->size == b->size && a->workers == b->workers;
+}
+
+/* La referencia de cada bloque (grupo, tamaño, workers) es su primera variante */
+static const MicroResult* blockBaseline(const MicroSuite* s, int i) {
+    for (int j = 0; j < i; j++)
+        if (sameBlock(&s->results[j].c, &s->results[i].c)) return &s->results[j];
+    return &s->results[i];
+}
+
+static double relCI(const BenchSummary* sm) {
+    return sm->median > 0.0 ? 0.5 * (sm->medianHi - sm->medianLo) / sm->median : 0.0;
+}
+
+void microFinish(MicroSuite* s, const char* dirPath) {
+    printf("\n===== MICROBENCHMARKS (%s) =====\n", s->project);
+    printf("Ciclos: %s\n", s->counters.fd[PERF_CYCLES] >= 0 ? "contadores de hardware"
+                           : s->tscHz > 0.0 ? "referencia del TSC (frecuencia nominal)" : "no disponibles");
+
+    const MicroCase* prev = NULL;
+    for (int i = 0; i < s->count; i++) {
+        const MicroResult* r = &s->results[i];
+        if (prev == NULL || !sameBlock(prev, &r->c)) {
+            printf("\n%s  N=%ld  p=%d\n", r->c.group, r->c.size, r->c.workers);
+            printf("  %-16s %12s %12s %12s %8s %9s\n",
+                   "variante", "ns/op", "ops/ciclo", "bytes/ciclo", "IC", "vs ref");
+        }
+        prev = &r->c;
+
+        char opc[16] = "-", bpc[16] = "-";
+        if (r->cyclesPerCall > 0.0) {
+            snprintf(opc, sizeof(opc), "%.3f", r->c.ops / r->cyclesPerCall);
+            if (r->c.bytes > 0.0) snprintf(bpc, sizeof(bpc), "%.3f", r->c.bytes / r->cyclesPerCall);
+        }
+        const MicroResult* base = blockBaseline(s, i);
+        printf("  %-16s %12.4f %12s %12s %7.2f%% %8.2fx\n", r->c.variant,
+               1e9 * r->secondsPerCall / r->c.ops, opc, bpc, 100.0 * relCI(&r->summary),
+               base->secondsPerCall / r->secondsPerCall);
+    }
+
+    benchEnsureDir(dirPath);
+    char filename[512];
+    snprintf(filename, sizeof(filename), "%s/Microbench.csv", dirPath);
+    ensureCSVHeader(filename, MICROBENCH_CSV_HEADER);
+    FILE* f = fopen(filename, "a");
+    if (f == NULL) {
+        fprintf(stderr, "Error: no se pudo abrir %s\n", filename);
+    } else {
+        const char* machineId = machineInfoGet()->machine_id;
+        for (int i = 0; i < s->count; i++) {
+            const MicroResult* r = &s->results[i];
+            fprintf(f, "%s,%s,%s,%ld,%d,%ld,%d,%.9f,%.5f,%.6f,", s->project, r->c.group, r->c.variant,
+                    r->c.size, r->c.workers, r->calls, r->summary.n, r->secondsPerCall,
+                    relCI(&r->summary), 1e9 * r->secondsPerCall / r->c.ops);
+            /* Sin ciclos ni tráfico las columnas quedan vacías */
+            if (r->cyclesPerCall > 0.0) fprintf(f, "%.6f", r->c.ops / r->cyclesPerCall);
+            fputc(',', f);
+            if (r->cyclesPerCall > 0.0 && r->c.bytes > 0.0) fprintf(f, "%.6f", r->c.bytes / r->cyclesPerCall);
+            fprintf(f, ",%s,%.4f,%s\n",
+                    r->cyclesPerCall <= 0.0 ? "" : r->pmuCycles ? "pmu" : "tsc",
+                    blockBaseline(s, i)->secondsPerCall / r->secondsPerCall, machineId);
+        }
+        fclose(f);
+        machineInfoWrite(dirPath);
+        printf("\nResultados en: %s\n", filename);
+    }
+
+    perfCountersClose(&s->counters);
+    free(s->results);
+    s->results = NULL;
+    s->count = s->capacity = 0;
+}
@@ -0,0 +1,81 @@
+#ifndef MICROBENCH_H
+#define MICROBENCH_H
+
+#include "hpcbench.h"
+#include "perfCounters.h"
+
+/* ==========================================
+ * Microbenchmarks de kernels aislados
+ * ==========================================
+ * Cada subproyecto tiene un binario microbench (make microbench) que mide
+ * sus kernels sin el programa completo alrededor: sin generar CSV por
+ * corrida, sin roofline ni estudio de escalabilidad, solo la llamada al
+ * kernel sobre una grilla de parámetros.
+ *
+ *   MicroSuite suite;
+ *   BenchSweep grid;                       // sizes=/threads= de argv
+ *   microInit(&suite, "caso2", &grid, argc, argv);
+ *   if (grid.nsizes == 0) ...tamaños por defecto...   // idem nworkers
+ *   for (...cada tamaño e hilos...) {
+ *       MicroCase c = { "gemm", "ikj", n, 1, ops, bytes };
+ *       microRun(&suite, &c, kernelIkj, &ctx);
+ *       c.variant = "bloques"; microRun(&suite, &c, kernelBlocked, &ctx);
+ *   }
+ *   microFinish(&suite, dir);              // tabla comparativa + Microbench.csv
+ *
+ * Cada muestra repite el kernel las veces necesarias para durar al menos
+ * MICRO_MIN_SAMPLE_S y las repeticiones siguen el modo adaptativo de
+ * hpcbench (IC de la mediana ±2% si no se fija BENCH_TARGET_CI). Los
+ * ciclos salen de los contadores de hardware; sin PMU (máquinas
+ * virtuales) se usan ciclos de referencia del TSC, que avanza a la
+ * frecuencia nominal y no a la real.
+ *
+ * Opciones (además de las del barrido): filter=texto mide solo las
+ * variantes cuyo nombre contiene el texto.
+ */
+#define MICRO_MIN_SAMPLE_S 2e-3
+
+typedef void (*MicroKernelFn)(void* ctx);
+
+typedef struct {
+    const char* group;      // kernel que se compara (gemm, gemv, dartboard...)
+    const char* variant;    // implementación concreta
+    long size;
+    int workers;
+    double ops;             // operaciones por llamada
+    double bytes;           // tráfico mínimo por llamada (0 si no aplica)
+} MicroCase;
+
+typedef struct {
+    MicroCase c;
+    long calls;             // llamadas por muestra
+    BenchSummary summary;   // tiempo por muestra
+    double secondsPerCall;  // mediana
+    double cyclesPerCall;   // -1 si no hay ni PMU ni TSC
+    int pmuCycles;          // 1: ciclos medidos; 0: ciclos de referencia (TSC)
+} MicroResult;
+
+typedef struct {
+    const char* project;
+    BenchConfig cfg;
+    const char* filter;
+    PerfCounters counters;
+    double tscHz;           // 0 si la arquitectura no tiene TSC
+    int count;
+    int capacity;
+    MicroResult* results;
+} MicroSuite;
+
+/* grid queda con sizes=/threads= de argv (nsizes/nworkers en 0 si no vinieron) */
+void microInit(MicroSuite* s, const char* project, BenchSweep* grid, int argc, char* argv[]);
+/* 1 si la variante pasa el filtro (para no preparar datos de más) */
+int microWants(const MicroSuite* s, const char* variant);
+void microRun(MicroSuite* s, const MicroCase* c, MicroKernelFn fn, void* ctx);
+/* Imprime la comparación por grupo, escribe dirPath/Microbench.csv y libera */
+void microFinish(MicroSuite* s, const char* dirPath);
+
+#define MICROBENCH_CSV_HEADER \
+    "project,group,variant,size,workers,calls,reps,median_s,ci_rel,ns_per_op,ops_per_cycle," \
+    "bytes_per_cycle,cycle_source,speedup,machine_id"
+
+#endif
@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "perfCounters.h"
+
+static const char* counterNames[PERF_NUM_COUNTERS] = {
+    "cycles",
+    "instructions",
+    "l1d_misses",
+    "llc_misses",
+    "dtlb_misses",
+    "branch_misses"
+};
+
+#define CACHE_READ_MISS(cache) \
+    ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+static void counterConfig(PerfCounterId id, struct perf_event_attr* attr) {
+    switch (id) {
+    case PERF_CYCLES:
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case PERF_INSTRUCTIONS:
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case PERF_L1D_MISSES:
+        attr->type = PERF_TYPE_HW_CACHE;
+        attr->config = CACHE_READ_MISS(PERF_COUNT_HW_CACHE_L1D);
+        break;
+    case PERF_LLC_MISSES:
+        attr->type = PERF_TYPE_HW_CACHE;
+        attr->config = CACHE_READ_MISS(PERF_COUNT_HW_CACHE_LL);
+        break;
+    case PERF_DTLB_MISSES:
+        attr->type = PERF_TYPE_HW_CACHE;
+        attr->config = CACHE_READ_MISS(PERF_COUNT_HW_CACHE_DTLB);
+        break;
+    case PERF_BRANCH_MISSES:
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    default:
+        break;
+    }
+}
+
+void perfCountersOpen(PerfCounters* pc) {
+    pc->available = 0;
+    for (int c = 0; c < PERF_NUM_COUNTERS; c++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        counterConfig((PerfCounterId)c, &attr);
+        attr.disabled = 1;
+        attr.inherit = 1;           // hilos y procesos hijos
+        attr.exclude_kernel = 1;    // funciona con perf_event_paranoid=2
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        pc->fd[c] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        pc->value[c] = -1;
+        if (pc->fd[c] >= 0) pc->available++;
+    }
+    perfCountersReset(pc);
+
+    if (pc->available < PERF_NUM_COUNTERS) {
+        fprintf(stderr, "Aviso: %d/%d contadores de hardware disponibles "
+                        "(revisar /proc/sys/kernel/perf_event_paranoid)\n",
+                pc->available, PERF_NUM_COUNTERS);
+    }
+}
+
+void perfCountersStart(PerfCounters* pc) {
+    for (int c = 0; c < PERF_NUM_COUNTERS; c++) {
+        if (pc->fd[c] < 0) continue;
+        ioctl(pc->fd[c], PERF_EVENT_IOC_RESET, 0);
+    }
+    for (int c = 0; c < PERF_NUM_COUNTERS; c++) {
+        if (pc->fd[c] < 0) continue;
+        ioctl(pc->fd[c], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+void perfCountersStop(PerfCounters* pc) {
+    for (int c = 0; c < PERF_NUM_COUNTERS; c++) {
+        if (pc->fd[c] < 0) continue;
+        ioctl(pc->fd[c], PERF_EVENT_IOC_DISABLE, 0);
+    }
+
+    for (int c = 0; c < PERF_NUM_COUNTERS; c++) {
+        if (pc->fd[c] < 0) continue;
+
+        /* value, time_enabled, time_running */
+        unsigned long long buf[3];
+        if (read(pc->fd[c], buf, sizeof(buf)) != (ssize_t)sizeof(buf) || buf[2] == 0) {
+            pc->value[c] = -1;
+            continue;
+        }
+        /* Escalar si el kernel multiplexó el contador */
+        double scale = (buf[1] > buf[2]) ? (double)buf[1] / buf[2] : 1.0;
+        pc->value[c] = (long long)(buf[0] * scale);
+    }
+}
+
+void perfCountersReset(PerfCounters* pc) {
+    for (int c = 0; c < PERF_NUM_COUNTERS; c++) pc->sum[c] = 0;
+    pc->runs = 0;
+}
+
+void perfCountersAccumulate(PerfCounters* pc) {
+    for (int c = 0; c < PERF_NUM_COUNTERS; c++) {
+        if (pc->sum[c] < 0) continue;
+        pc->sum[c] = (pc->value[c] >= 0) ? pc->sum[c] + pc->value[c] : -1;
+    }
+    pc->runs++;
+}
+
+void perfCountersClose(PerfCounters* pc) {
+    for (int c = 0; c < PERF_NUM_COUNTERS; c++) {
+        if (pc->fd[c] >= 0) close(pc->fd[c]);
+        pc->fd[c] = -1;
+    }
+    pc->available = 0;
+}
+
+void perfCountersWriteCSV(FILE* f, const PerfCounters* pc) {
+    for (int c = 0; c < PERF_NUM_COUNTERS; c++) {
+        if (c > 0) fputc(',', f);
+        if (pc->value[c] >= 0) fprintf(f, "%lld", pc->value[c]);
+    }
+}
+
+void perfCountersPrint(const PerfCounters* pc) {
+    if (pc->available == 0) {
+        printf("Contadores de hardware: no disponibles\n");
+        return;
+    }
+    printf("Contadores de hardware:\n");
+    for (int c = 0; c < PERF_NUM_COUNTERS; c++) {
+        if (pc->value[c] >= 0) printf("  %-14s %lld\n", counterNames[c], pc->value[c]);
+        else printf("  %-14s n/d\n", counterNames[c]);
+    }
+    if (pc->value[PERF_CYCLES] > 0 && pc->value[PERF_INSTRUCTIONS] >= 0)
+        printf("  %-14s %.3f\n", "IPC",
+               (double)pc->value[PERF_INSTRUCTIONS] / pc->value[PERF_CYCLES]);
+}
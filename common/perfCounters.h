@@ -0,0 +1,58 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <stdio.h>
+
+/* ==========================================
+ * Contadores de hardware en proceso (perf_event_open)
+ * ==========================================
+ * Uso:
+ *   PerfCounters pc;
+ *   perfCountersOpen(&pc);     // al inicio, antes de crear hilos/procesos
+ *   perfCountersStart(&pc);    // justo antes de la región medida
+ *   ...
+ *   perfCountersStop(&pc);     // justo después
+ *
+ * Con repeticiones: perfCountersReset antes del bucle y
+ * perfCountersAccumulate tras cada Stop que no sea calentamiento; `sum`
+ * y `runs` dan el promedio por repetición medida.
+ *
+ * Los eventos se abren con `inherit`, así que cuentan también los hilos
+ * (pthreads, OpenMP) y procesos hijos creados después de abrirlos. Si el
+ * kernel no lo permite (perf_event_paranoid, contenedores, máquinas
+ * virtuales sin PMU) el contador queda como no disponible y se reporta
+ * vacío en el CSV; el programa sigue normalmente.
+ */
+typedef enum {
+    PERF_CYCLES = 0,
+    PERF_INSTRUCTIONS,
+    PERF_L1D_MISSES,
+    PERF_LLC_MISSES,
+    PERF_DTLB_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_NUM_COUNTERS
+} PerfCounterId;
+
+typedef struct {
+    int fd[PERF_NUM_COUNTERS];
+    long long value[PERF_NUM_COUNTERS];     // última región; -1 si no disponible
+    long long sum[PERF_NUM_COUNTERS];       // regiones acumuladas; -1 si alguna faltó
+    int runs;                               // regiones acumuladas
+    int available;                          // número de contadores abiertos
+} PerfCounters;
+
+void perfCountersOpen(PerfCounters* pc);
+void perfCountersStart(PerfCounters* pc);
+void perfCountersStop(PerfCounters* pc);
+void perfCountersClose(PerfCounters* pc);
+void perfCountersReset(PerfCounters* pc);
+void perfCountersAccumulate(PerfCounters* pc);
+
+/* Columnas CSV en el mismo orden que PerfCounterId */
+#define PERF_CSV_HEADER "cycles,instructions,l1d_misses,llc_misses,dtlb_misses,branch_misses"
+
+/* Escribe los valores separados por coma (vacío si no disponible) */
+void perfCountersWriteCSV(FILE* f, const PerfCounters* pc);
+void perfCountersPrint(const PerfCounters* pc);
+
+#endif
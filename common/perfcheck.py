@@ -0,0 +1,266 @@
+"""
+Detección de regresiones de rendimiento (make perfcheck).
+
+Compara las muestras de una corrida corta contra una línea base guardada:
+
+    python3 ../common/perfcheck.py --baseline perfcheck/baseline.csv \
+        --current perfcheck/run/current.csv --summary perfcheck/run/summary.csv
+
+Formatos aceptados (se detectan por las columnas):
+  - muestras de hpcbench (BENCH_SAMPLES / samples=):
+        project,program,variant,size,workers,rep,time_s,machine_id
+  - CSV históricos con una fila por corrida, p. ej.
+        modo,algoritmo,tamaño,workers,iteracion,tiempo          (reto1/reto2)
+        size,threads,real_time,...,algorithm                    (caso2)
+
+Para cada configuración (programa, variante, tamaño, workers) presente en
+ambos archivos se aplica la prueba U de Mann-Whitney de una cola (¿la
+corrida actual es más lenta?). Es regresión si la mediana empeora más que
+--threshold y p < --alpha. Sale con código 1 si hay alguna regresión y con
+2 si no hay nada comparable.
+
+Con --update se reemplazan en la línea base las filas de esta máquina por
+las de la corrida actual (make perfcheck-baseline).
+
+Solo usa la biblioteca estándar: debe correr donde se compilan los binarios.
+"""
+import argparse
+import csv
+import math
+import os
+import statistics
+import sys
+
+SIZE_COLUMNS = ["size", "tamaño", "N", "n"]
+WORKER_COLUMNS = ["workers", "threads", "num_threads", "num_procs"]
+TIME_COLUMNS = ["time_s", "real_time", "tiempo"]
+VARIANT_COLUMNS = ["variant", "algorithm", "algoritmo"]
+KEY_COLUMNS = ["project", "program", "variant"]
+
+SAMPLES_HEADER = ["project", "program", "variant", "size", "workers", "rep", "time_s", "machine_id"]
+
+
+def primera_columna(campos, candidatas):
+    for c in candidatas:
+        if c in campos:
+            return c
+    return None
+
+
+def cargar_muestras(path):
+    """Devuelve (filas normalizadas, columnas de clave disponibles, ¿trae machine_id?)."""
+    with open(path, newline="") as f:
+        lector = csv.DictReader(f)
+        campos = lector.fieldnames or []
+        col_size = primera_columna(campos, SIZE_COLUMNS)
+        col_time = primera_columna(campos, TIME_COLUMNS)
+        if col_size is None or col_time is None:
+            sys.exit(f"Error: {path} no tiene columnas de tamaño y tiempo reconocibles")
+        col_workers = primera_columna(campos, WORKER_COLUMNS)
+        col_variant = primera_columna(campos, VARIANT_COLUMNS)
+
+        claves = []
+        if "project" in campos:
+            claves.append("project")
+        if "program" in campos:
+            claves.append("program")
+        if col_variant is not None:
+            claves.append("variant")
+        con_maquina = "machine_id" in campos
+
+        filas = []
+        for r in lector:
+            try:
+                fila = {
+                    "size": int(float(r[col_size])),
+                    "workers": int(float(r[col_workers])) if col_workers else 1,
+                    "time_s": float(r[col_time]),
+                }
+            except (TypeError, ValueError):
+                continue
+            if "project" in claves:
+                fila["project"] = r["project"]
+            if "program" in claves:
+                fila["program"] = r["program"]
+            if col_variant is not None:
+                fila["variant"] = r[col_variant].strip().lower()
+            fila["machine_id"] = r.get("machine_id") or ""
+            fila["rep"] = r.get("rep") or r.get("iteracion") or ""
+            filas.append(fila)
+    return filas, claves, con_maquina
+
+
+def agrupar(filas, claves):
+    grupos = {}
+    for r in filas:
+        k = tuple(r[c] for c in claves) + (r["size"], r["workers"])
+        grupos.setdefault(k, []).append(r["time_s"])
+    return grupos
+
+
+def mann_whitney_mayor(actual, base):
+    """p-valor de una cola para H1: 'actual' tiende a ser mayor que 'base'.
+    Aproximación normal con corrección por empates y por continuidad."""
+    n1, n2 = len(actual), len(base)
+    todos = sorted([(v, 0) for v in actual] + [(v, 1) for v in base])
+    rangos = [0.0] * len(todos)
+    empates = 0.0
+    i = 0
+    while i < len(todos):
+        j = i
+        while j + 1 < len(todos) and todos[j + 1][0] == todos[i][0]:
+            j += 1
+        rango = (i + j) / 2.0 + 1.0
+        for k in range(i, j + 1):
+            rangos[k] = rango
+        t = j - i + 1
+        empates += t ** 3 - t
+        i = j + 1
+
+    r1 = sum(r for r, (_, g) in zip(rangos, todos) if g == 0)
+    u = r1 - n1 * (n1 + 1) / 2.0
+    n = n1 + n2
+    media = n1 * n2 / 2.0
+    var = n1 * n2 / 12.0 * ((n + 1) - empates / (n * (n - 1)))
+    if var <= 0:
+        return 1.0
+    z = (u - media - 0.5) / math.sqrt(var)
+    return 0.5 * math.erfc(z / math.sqrt(2.0))
+
+
+def comparar(base, actual, claves, umbral, alfa):
+    g_base = agrupar(base, claves)
+    g_act = agrupar(actual, claves)
+    filas = []
+    for k in sorted(g_act, key=lambda x: tuple(str(v) for v in x)):
+        muestras = g_act[k]
+        nombre = "/".join(str(v) for v in k[:len(claves)]) or "-"
+        size, workers = k[len(claves)], k[len(claves) + 1]
+        med_act = statistics.median(muestras)
+        if k not in g_base:
+            filas.append([nombre, size, workers, 0, len(muestras), "", f"{med_act:.9f}", "", "", "SIN_BASE"])
+            continue
+        ref = g_base[k]
+        med_base = statistics.median(ref)
+        cambio = (med_act / med_base - 1.0) if med_base > 0 else 0.0
+        if len(ref) < 2 or len(muestras) < 2:
+            p_lento, p_rapido, estado = float("nan"), float("nan"), "POCAS_MUESTRAS"
+        else:
+            p_lento = mann_whitney_mayor(muestras, ref)
+            p_rapido = mann_whitney_mayor(ref, muestras)
+            if cambio > umbral and p_lento < alfa:
+                estado = "REGRESION"
+            elif cambio < -umbral and p_rapido < alfa:
+                estado = "MEJORA"
+            else:
+                estado = "OK"
+        p = p_lento if cambio >= 0 else p_rapido
+        filas.append([nombre, size, workers, len(ref), len(muestras),
+                      f"{med_base:.9f}", f"{med_act:.9f}", f"{100.0 * cambio:+.1f}",
+                      "" if math.isnan(p) else f"{p:.4f}", estado])
+    return filas
+
+
+def imprimir_tabla(encabezado, filas):
+    anchos = [max(len(str(c)) for c in col) for col in zip(encabezado, *filas)]
+    linea = "  ".join("{:<" + str(a) + "}" for a in anchos)
+    print(linea.format(*encabezado))
+    print("  ".join("-" * a for a in anchos))
+    for f in filas:
+        print(linea.format(*[str(c) for c in f]))
+
+
+def actualizar_base(path_base, actual):
+    """Reemplaza las filas de las máquinas de la corrida actual en la línea base."""
+    maquinas = {r["machine_id"] for r in actual}
+    conservadas = []
+    if os.path.exists(path_base):
+        with open(path_base, newline="") as f:
+            lector = csv.DictReader(f)
+            if lector.fieldnames != SAMPLES_HEADER:
+                sys.exit(f"Error: {path_base} no está en el formato de muestras de hpcbench")
+            conservadas = [r for r in lector if r["machine_id"] not in maquinas]
+
+    os.makedirs(os.path.dirname(path_base) or ".", exist_ok=True)
+    with open(path_base, "w", newline="") as f:
+        escritor = csv.DictWriter(f, fieldnames=SAMPLES_HEADER)
+        escritor.writeheader()
+        escritor.writerows(conservadas)
+        for r in actual:
+            escritor.writerow({c: r.get(c, "") for c in SAMPLES_HEADER})
+    print(f"✅ Línea base actualizada: {path_base} ({len(actual)} muestras de esta máquina)")
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Compara una corrida contra la línea base guardada")
+    ap.add_argument("--baseline", required=True)
+    ap.add_argument("--current", required=True)
+    ap.add_argument("--summary", help="CSV con la tabla resumen")
+    ap.add_argument("--threshold", type=float, default=0.10,
+                    help="empeoramiento relativo de la mediana tolerado (0.10 = 10%%)")
+    ap.add_argument("--alpha", type=float, default=0.01, help="nivel de significancia")
+    ap.add_argument("--update", action="store_true",
+                    help="guardar la corrida actual como línea base de esta máquina")
+    args = ap.parse_args()
+
+    if not os.path.exists(args.current):
+        sys.exit(f"Error: no existe la corrida actual {args.current}")
+    actual, claves_act, maquina_act = cargar_muestras(args.current)
+    if not actual:
+        sys.exit(f"Error: {args.current} no tiene muestras")
+
+    if args.update:
+        with open(args.current, newline="") as f:
+            actual_crudo = list(csv.DictReader(f))
+        actual_crudo = [r for r in actual_crudo if r.get("time_s")]
+        for r in actual_crudo:
+            r.setdefault("machine_id", "")
+        actualizar_base(args.baseline, actual_crudo)
+        return 0
+
+    if not os.path.exists(args.baseline):
+        print(f"❌ No hay línea base en {args.baseline}; créela con 'make perfcheck-baseline'")
+        return 2
+    base, claves_base, maquina_base = cargar_muestras(args.baseline)
+
+    # Solo tiene sentido comparar contra la misma máquina (ver machineInfo.h)
+    if maquina_act and maquina_base:
+        ids = {r["machine_id"] for r in actual}
+        base = [r for r in base if r["machine_id"] in ids]
+        if not base:
+            print(f"❌ La línea base no tiene muestras de esta máquina ({', '.join(sorted(ids))}); "
+                  "créela con 'make perfcheck-baseline'")
+            return 2
+    else:
+        print("⚠️ La línea base no trae machine_id: se compara sin saber si es la misma máquina")
+
+    claves = [c for c in KEY_COLUMNS if c in claves_act and c in claves_base]
+    filas = comparar(base, actual, claves, args.threshold, args.alpha)
+
+    encabezado = ["config", "size", "workers", "n_base", "n_actual", "mediana_base_s",
+                  "mediana_actual_s", "cambio_pct", "p_valor", "estado"]
+    print(f"\n===== PERFCHECK (umbral {100 * args.threshold:.0f}%, alfa {args.alpha}) =====")
+    imprimir_tabla(encabezado, filas)
+
+    if args.summary:
+        os.makedirs(os.path.dirname(args.summary) or ".", exist_ok=True)
+        with open(args.summary, "w", newline="") as f:
+            escritor = csv.writer(f)
+            escritor.writerow(encabezado)
+            escritor.writerows(filas)
+        print(f"\nResumen guardado en: {args.summary}")
+
+    estados = [f[-1] for f in filas]
+    if all(e == "SIN_BASE" for e in estados):
+        print("❌ Ninguna configuración de la corrida está en la línea base")
+        return 2
+    regresiones = estados.count("REGRESION")
+    if regresiones:
+        print(f"❌ {regresiones} regresión(es) de rendimiento")
+        return 1
+    print("✅ Sin regresiones")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,134 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+
+#include "procPool.h"
+
+/* Cada cuánto revisa el padre, mientras espera, que ningún hijo haya muerto */
+#define PROC_POOL_CHECK_NS 100000000L
+
+/* FUTEX_WAIT/WAKE sin _PRIVATE: la palabra está en un mmap compartido entre procesos */
+static long futexWait(uint32_t* addr, uint32_t val, const struct timespec* timeout) {
+    return syscall(SYS_futex, addr, FUTEX_WAIT, val, timeout, NULL, 0);
+}
+
+static void futexWake(uint32_t* addr, int count) {
+    syscall(SYS_futex, addr, FUTEX_WAKE, count, NULL, NULL, 0);
+}
+
+int procPoolEnabled(void) {
+    const char* v = getenv("PROC_POOL");
+    if (v == NULL || *v == '\0' || strcmp(v, "1") == 0) return 1;
+    if (strcmp(v, "0") == 0) return 0;
+    fprintf(stderr, "Error: PROC_POOL=%s inválido (1 o 0)\n", v);
+    exit(EXIT_FAILURE);
+}
+
+/* Cada hijo duerme en su propia palabra: solo se despierta en las generaciones
+ * en que participa, y el padre no toca task/arg hasta que todos los que
+ * despertó bajaron pending, así que lee el trabajo de esa generación y no otro. */
+static void workerLoop(ProcPoolShared* sh, int id) {
+    uint32_t* seq = &sh->worker[id].seq;
+    uint32_t seen = 0;
+    for (;;) {
+        while (__atomic_load_n(seq, __ATOMIC_ACQUIRE) == seen)
+            futexWait(seq, seen, NULL);
+        seen++;
+        if (sh->quit) _exit(0);
+
+        sh->task(sh->arg, id);
+        if (__atomic_sub_fetch(&sh->pending, 1, __ATOMIC_ACQ_REL) == 0)
+            futexWake(&sh->pending, 1);
+    }
+}
+
+/* Publica una generación para el hijo id */
+static void wakeWorker(ProcPoolShared* sh, int id) {
+    __atomic_add_fetch(&sh->worker[id].seq, 1, __ATOMIC_RELEASE);
+    futexWake(&sh->worker[id].seq, 1);
+}
+
+ProcPool* procPoolCreate(int workers) {
+    ProcPool* p = malloc(sizeof(ProcPool));
+    if (p == NULL) {
+        perror("malloc");
+        exit(EXIT_FAILURE);
+    }
+    p->workers = workers;
+    p->pids = malloc((size_t)workers * sizeof(pid_t));
+    p->shBytes = sizeof(ProcPoolShared) + (size_t)workers * sizeof(ProcPoolWorker);
+    p->sh = mmap(NULL, p->shBytes, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (p->pids == NULL || p->sh == MAP_FAILED) {
+        perror("procPoolCreate");
+        exit(EXIT_FAILURE);
+    }
+    memset(p->sh, 0, p->shBytes);
+
+    fflush(NULL);           // que los hijos no hereden salida pendiente
+    const pid_t parent = getpid();
+    for (int i = 0; i < workers; i++) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            perror("fork");
+            exit(EXIT_FAILURE);
+        }
+        if (pid == 0) {
+            /* Si el padre muere (exit por error, señal) los hijos no quedan huérfanos */
+            prctl(PR_SET_PDEATHSIG, SIGKILL);
+            if (getppid() != parent) _exit(0);
+            workerLoop(p->sh, i);
+        }
+        p->pids[i] = pid;
+    }
+    return p;
+}
+
+/* Un hijo que terminó antes de procPoolFree dejaría al padre esperando para siempre */
+static void checkWorkers(const ProcPool* p) {
+    for (int i = 0; i < p->workers; i++) {
+        int status;
+        if (waitpid(p->pids[i], &status, WNOHANG) == p->pids[i]) {
+            fprintf(stderr, "Error: el worker %d del pool de procesos terminó (estado %d)\n",
+                    i, status);
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+void procPoolRun(ProcPool* p, int active, ProcPoolTask task, void* arg) {
+    if (active < 1 || active > p->workers) {
+        fprintf(stderr, "Error: %d workers pedidos a un pool de %d procesos\n", active, p->workers);
+        exit(EXIT_FAILURE);
+    }
+    ProcPoolShared* sh = p->sh;
+    sh->task = task;
+    sh->arg = arg;
+    __atomic_store_n(&sh->pending, (uint32_t)active, __ATOMIC_RELAXED);
+    for (int i = 0; i < active; i++) wakeWorker(sh, i);
+
+    const struct timespec check = { 0, PROC_POOL_CHECK_NS };
+    uint32_t left;
+    while ((left = __atomic_load_n(&sh->pending, __ATOMIC_ACQUIRE)) != 0) {
+        if (futexWait(&sh->pending, left, &check) == -1 && errno == ETIMEDOUT) checkWorkers(p);
+    }
+}
+
+void procPoolFree(ProcPool* p) {
+    if (p == NULL) return;
+    p->sh->quit = 1;
+    for (int i = 0; i < p->workers; i++) wakeWorker(p->sh, i);
+    for (int i = 0; i < p->workers; i++) waitpid(p->pids[i], NULL, 0);
+    munmap(p->sh, p->shBytes);
+    free(p->pids);
+    free(p);
+}
@@ -0,0 +1,73 @@
+#ifndef PROC_POOL_H
+#define PROC_POOL_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+/* ==========================================
+ * Pool persistente de procesos
+ * ==========================================
+ * Los hijos se crean una sola vez con fork y quedan dormidos, cada uno en
+ * su propio futex; el padre publica el trabajo en un único slot compartido
+ * (task, arg) y despierta solo a los hijos que participan, y el último en
+ * terminar despierta al padre. Así una repetición (o una configuración
+ * entera de un barrido) ya no paga fork, copia de tablas de páginas ni
+ * wait, que a N chico dominan el tiempo.
+ *
+ * No es una cola: hay un solo trabajo en vuelo y procPoolRun no vuelve
+ * hasta que terminó, así que el slot no se pisa. Un hijo que no participa
+ * de una generación no se despierta y no puede leer el trabajo de la
+ * siguiente (con active alternando entre 1 y N, como en un barrido de hilos).
+ *
+ *   ProcPool* pool = procPoolCreate(maxWorkers);   // antes de medir
+ *   while (benchRunNext(&run)) {
+ *       benchStart(&run);
+ *       procPoolRun(pool, workers, task, arg);     // task(arg, id), id < workers
+ *       benchStop(&run);
+ *   }
+ *   procPoolFree(pool);
+ *
+ * Los hijos ven la memoria del padre tal como estaba al crear el pool: arg
+ * y todo lo que task escriba o lea de la repetición en curso tiene que vivir
+ * en memoria compartida creada antes (mmap MAP_SHARED o shm de System V),
+ * o no cambiar después de procPoolCreate.
+ *
+ * Los contadores de hardware abiertos con `inherit` antes de procPoolCreate
+ * siguen valiendo: read, enable, disable y reset sobre el descriptor del
+ * padre incluyen a los hijos vivos. El tiempo de CPU de los hijos no:
+ * getrusage(RUSAGE_CHILDREN) solo lo suma cuando un hijo termina y es
+ * esperado, es decir en procPoolFree, así que con el pool user/system
+ * quedan vacíos (benchCpuTimeUnknown). PROC_POOL=0 vuelve a un fork por
+ * repetición para medirlos.
+ */
+
+typedef void (*ProcPoolTask)(void* arg, int worker);
+
+/* Una línea de caché por hijo para que despertar a uno no invalide a los demás */
+typedef struct {
+    uint32_t seq;           // generaciones publicadas para este hijo: su futex
+} __attribute__((aligned(64))) ProcPoolWorker;
+
+typedef struct {
+    ProcPoolTask task;      // slot del trabajo en vuelo
+    void* arg;
+    int quit;
+    uint32_t pending __attribute__((aligned(64)));  // hijos sin terminar: futex del padre
+    ProcPoolWorker worker[];
+} ProcPoolShared;
+
+typedef struct {
+    int workers;
+    pid_t* pids;
+    size_t shBytes;
+    ProcPoolShared* sh;     // mmap compartido con los hijos
+} ProcPool;
+
+/* 1 salvo con PROC_POOL=0 */
+int procPoolEnabled(void);
+ProcPool* procPoolCreate(int workers);
+/* Corre task(arg, id) en los hijos 0..active-1 y espera a que terminen */
+void procPoolRun(ProcPool* p, int active, ProcPoolTask task, void* arg);
+void procPoolFree(ProcPool* p);
+
+#endif
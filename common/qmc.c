@@ -0,0 +1,46 @@
+#include "qmc.h"
+#include "rng.h"
+
+/* ==========================================
+ * Sobol
+ * ========================================== */
+void sobolInit(Sobol2* s, uint64_t seed, int randomize) {
+    /* Dimensión 1: v_k = 2^(31-k). Dimensión 2 (polinomio x + 1, m_1 = 1):
+     * m_k = m_{k-1} ^ (2·m_{k-1}) y v_k = m_k · 2^(31-k) */
+    uint32_t m = 1;
+    for (int k = 0; k < QMC_BITS; k++) {
+        s->v[0][k] = 1u << (31 - k);
+        if (k > 0) m ^= m << 1;
+        s->v[1][k] = m << (31 - k);
+    }
+    /* sobolSamples avanza también después del punto 2^32 - 1 (i + 1 = 2^32) */
+    s->v[0][QMC_BITS] = s->v[1][QMC_BITS] = 0;
+    s->shift[0] = randomize ? (uint32_t)(rngAt(seed, 0) >> 32) : 0;
+    s->shift[1] = randomize ? (uint32_t)(rngAt(seed, 1) >> 32) : 0;
+}
+
+/* ==========================================
+ * Halton
+ * ========================================== */
+/* Sin aleatorizar se usa la permutación fija (0 2 1) en base 3 (Faure),
+ * que ya rompe el patrón de las primeras cifras */
+void haltonInit(Halton2* h, uint64_t seed, int randomize) {
+    h->mask2 = randomize ? (uint32_t)(rngAt(seed, 2) >> 32) : 0;
+    for (int d = 0; d < QMC_BASE3_DIGITS; d++) {
+        uint8_t p[3] = { 0, 2, 1 };
+        if (randomize) {
+            /* Fisher-Yates con la salida 3 + d de la semilla */
+            const uint64_t r = rngAt(seed, 3 + (uint64_t)d);
+            p[0] = 0, p[1] = 1, p[2] = 2;
+            for (int j = 2; j > 0; j--) {
+                const int k = (int)((r >> (8 * j)) % (uint64_t)(j + 1));
+                const uint8_t tmp = p[j];
+                p[j] = p[k];
+                p[k] = tmp;
+            }
+        }
+        for (int j = 0; j < 3; j++) h->perm3[d][j] = p[j];
+    }
+    uint64_t w = 1;
+    for (int d = QMC_BASE3_DIGITS - 1; d >= 0; d--, w *= 3) h->w3[d] = w;
+}
@@ -0,0 +1,114 @@
+#ifndef QMC_H
+#define QMC_H
+
+#include <stdint.h>
+
+/* ==========================================
+ * Secuencias de baja discrepancia en 2D
+ * ==========================================
+ * El punto i depende solo de i (y de la aleatorización), así que cada
+ * worker arranca en el primer índice de su rango sin generar los
+ * anteriores, como el modo contador. Índices menores que 2^32
+ * (QMC_MAX_POINTS): más allá Sobol se queda sin números de dirección y el
+ * radical inverso en base 2 da la vuelta, así que los programas rechazan N
+ * mayores.
+ *
+ * Sobol: dimensiones 1 y 2 de Joe y Kuo (van der Corput en base 2 y el
+ * polinomio x + 1), en orden de código Gray: el punto i+1 es el punto i
+ * con un solo XOR por dimensión (la dirección del bit menos significativo
+ * que cambia). Aleatorizado con un desplazamiento digital (XOR) por
+ * dimensión.
+ *
+ * Halton: bases 2 y 3 con las cifras permutadas por posición (Halton
+ * "scrambled"), que rompe la correlación entre dimensiones y, con
+ * permutaciones al azar, lo aleatoriza. En base 2 permutar cada cifra es
+ * un XOR con una máscara.
+ *
+ * Con aleatorización (RQMC) cada semilla da una réplica independiente e
+ * insesgada: el error se estima con la dispersión entre réplicas
+ * (scripts/qmc_error.py). Sin ella la secuencia es la clásica, fija.
+ */
+#define QMC_BITS 32
+#define QMC_BASE3_DIGITS 21     // 3^21 > 2^32
+#define QMC_MAX_POINTS (1L << QMC_BITS)
+
+typedef struct {
+    uint32_t v[2][QMC_BITS + 1];    // números de dirección; v[..][32] = 0 (paso tras el último punto)
+    uint32_t shift[2];          // desplazamiento digital (0 sin aleatorizar)
+} Sobol2;
+
+typedef struct {
+    uint32_t mask2;                         // permutación de cada cifra en base 2
+    uint8_t perm3[QMC_BASE3_DIGITS][3];     // permutación de cada cifra en base 3
+    uint64_t w3[QMC_BASE3_DIGITS];          // peso de la cifra d: 3^(20-d)
+} Halton2;
+
+/* Punto de Halton en base 3 como entero exacto (a escalar por 3^-21) y
+ * sus cifras, para pasar al siguiente sumando 1 con acarreo */
+typedef struct {
+    uint8_t digit[QMC_BASE3_DIGITS];
+    uint64_t value;
+} Halton3;
+
+#define QMC_BASE3_UNIT (1.0 / 10460353203.0)    // 3^-21
+
+void sobolInit(Sobol2* s, uint64_t seed, int randomize);
+void haltonInit(Halton2* h, uint64_t seed, int randomize);
+
+/* Punto i de Sobol (orden Gray) como enteros de 32 bits */
+static inline void sobolPoint(const Sobol2* s, uint64_t i, uint32_t* x, uint32_t* y) {
+    uint64_t g = i ^ (i >> 1);
+    uint32_t a = s->shift[0], b = s->shift[1];
+    for (int k = 0; g != 0; k++, g >>= 1) {
+        if (g & 1) {
+            a ^= s->v[0][k];
+            b ^= s->v[1][k];
+        }
+    }
+    *x = a;
+    *y = b;
+}
+
+/* Del punto i al i+1 */
+static inline void sobolNext(const Sobol2* s, uint64_t i, uint32_t* x, uint32_t* y) {
+    const int k = __builtin_ctzll(i + 1);
+    *x ^= s->v[0][k];
+    *y ^= s->v[1][k];
+}
+
+static inline uint32_t qmcReverse32(uint32_t x) {
+    x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+    x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+    x = ((x >> 4) & 0x0F0F0F0Fu) | ((x & 0x0F0F0F0Fu) << 4);
+    return __builtin_bswap32(x);
+}
+
+/* Radical inverso en base 2 (32 bits, a escalar por 2^-32) */
+static inline uint32_t haltonBase2(const Halton2* h, uint64_t i) {
+    return qmcReverse32((uint32_t)i) ^ h->mask2;
+}
+
+/* Radical inverso en base 3 del punto i. Se recorren las 21 cifras
+ * porque los ceros a la izquierda también se permutan */
+static inline void haltonBase3(const Halton2* h, uint64_t i, Halton3* p) {
+    p->value = 0;
+    for (int d = 0; d < QMC_BASE3_DIGITS; d++) {
+        const uint64_t q = i / 3;
+        p->digit[d] = (uint8_t)(i - 3 * q);
+        p->value += h->perm3[d][p->digit[d]] * h->w3[d];
+        i = q;
+    }
+}
+
+/* Del punto i al i+1: en promedio cambia 1.5 cifras */
+static inline void haltonNext3(const Halton2* h, Halton3* p) {
+    for (int d = 0; d < QMC_BASE3_DIGITS; d++) {
+        const uint8_t old = p->digit[d];
+        const uint8_t now = old == 2 ? 0 : old + 1;
+        p->digit[d] = now;
+        p->value += (h->perm3[d][now] - (uint64_t)h->perm3[d][old]) * h->w3[d];
+        if (now != 0) break;
+    }
+}
+
+#endif
@@ -0,0 +1,77 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "rng.h"
+
+/* ==========================================
+ * Inicialización
+ * ========================================== */
+/* Las cuatro palabras son las salidas 0..3 de splitmix64 desde `seed` */
+void rngSeed(Rng* r, uint64_t seed) {
+    for (int i = 0; i < 4; i++) r->s[i] = rngAt(seed, i);
+}
+
+/* Aplica el polinomio de salto `poly` (Blackman y Vigna) */
+static void applyJump(Rng* r, const uint64_t poly[4]) {
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (poly[i] & (1ULL << b)) {
+                s0 ^= r->s[0];
+                s1 ^= r->s[1];
+                s2 ^= r->s[2];
+                s3 ^= r->s[3];
+            }
+            rngNext(r);
+        }
+    }
+    r->s[0] = s0;
+    r->s[1] = s1;
+    r->s[2] = s2;
+    r->s[3] = s3;
+}
+
+void rngJump(Rng* r) {
+    static const uint64_t JUMP[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                     0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+    applyJump(r, JUMP);
+}
+
+void rngLongJump(Rng* r) {
+    static const uint64_t LONG_JUMP[] = { 0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL,
+                                          0x77710069854ee241ULL, 0x39109bb02acbe635ULL };
+    applyJump(r, LONG_JUMP);
+}
+
+void rngStream(Rng* r, uint64_t seed, int stream) {
+    rngSeed(r, seed);
+    for (int i = 0; i < stream; i++) rngJump(r);
+}
+
+void rngVecStream(RngVec* v, uint64_t seed, int stream) {
+    Rng r;
+    rngSeed(&r, seed);
+    for (int i = 0; i < stream; i++) rngLongJump(&r);
+    for (int j = 0; j < RNG_LANES; j++) {
+        for (int w = 0; w < 4; w++) v->s[w][j] = r.s[w];
+        rngJump(&r);
+    }
+}
+
+uint64_t rngSeedFromEnv(void) {
+    const char* v = getenv("RNG_SEED");
+    if (v != NULL && *v != '\0') {
+        char* end;
+        unsigned long long x = strtoull(v, &end, 10);
+        if (end == v || *end != '\0') {
+            fprintf(stderr, "Error: RNG_SEED=%s inválido\n", v);
+            exit(EXIT_FAILURE);
+        }
+        return (uint64_t)x;
+    }
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return ((uint64_t)ts.tv_sec << 32) ^ (uint64_t)ts.tv_nsec ^ ((uint64_t)getpid() << 16);
+}
@@ -0,0 +1,100 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+/* ==========================================
+ * Generador xoshiro256++ con flujos independientes
+ * ==========================================
+ * Estado de 256 bits, período 2^256 - 1. rngJump avanza 2^128 pasos, así
+ * que cada worker recibe su propio tramo de la secuencia sin solaparse con
+ * los demás (hasta 2^128 workers):
+ *
+ *   uint64_t seed = rngSeedFromEnv();        // una vez por corrida
+ *   ...en cada hilo/proceso, al empezar la región paralela:
+ *   Rng rng;
+ *   rngStream(&rng, seed, id);               // id-ésimo tramo de 2^128
+ *   double u = rngUniform(&rng);             // [0, 1) con 53 bits
+ *
+ * RNG_SEED=n fija la semilla (corridas reproducibles); sin ella se toma
+ * del reloj y el pid. rngNext/rngUniform son inline: en el bucle de
+ * muestras no hay llamada ni lock, a diferencia de rand().
+ *
+ * RngVec son RNG_LANES generadores en paralelo sobre vectores de GCC (un
+ * registro AVX-512, o dos AVX2, por palabra de estado): rngVecNext da
+ * RNG_LANES salidas por llamada. El flujo `stream` de RngVec salta 2^192
+ * (rngLongJump) por worker y 2^128 por carril, así que no se solapa con
+ * otros workers ni entre carriles.
+ *
+ * rngAt(seed, i) es contador: la i-ésima salida de splitmix64 calculada
+ * directamente, sin estado. Sirve cuando la muestra i debe ver siempre los
+ * mismos números sin importar qué worker la procesa ni en qué orden.
+ */
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+static inline uint64_t rngAt(uint64_t seed, uint64_t i) {
+    uint64_t z = seed + (i + 1) * 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t rngRotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t rngNext(Rng* r) {
+    uint64_t* s = r->s;
+    const uint64_t result = rngRotl(s[0] + s[3], 23) + s[0];
+    const uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rngRotl(s[3], 45);
+    return result;
+}
+
+/* Los 53 bits altos como double en [0, 1) */
+static inline double rngUniform(Rng* r) {
+    return (rngNext(r) >> 11) * 0x1.0p-53;
+}
+
+#define RNG_LANES 8
+
+typedef uint64_t RngLanes __attribute__((vector_size(RNG_LANES * sizeof(uint64_t))));
+
+typedef struct {
+    RngLanes s[4];
+} RngVec;
+
+static inline RngLanes rngVecNext(RngVec* r) {
+    RngLanes* s = r->s;
+    const RngLanes sum = s[0] + s[3];
+    const RngLanes result = ((sum << 23) | (sum >> 41)) + s[0];
+    const RngLanes t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 45) | (s[3] >> 19);
+    return result;
+}
+
+/* Estado inicial a partir de una semilla de 64 bits (splitmix64) */
+void rngSeed(Rng* r, uint64_t seed);
+/* Avanza 2^128 pasos */
+void rngJump(Rng* r);
+/* Avanza 2^192 pasos */
+void rngLongJump(Rng* r);
+/* rngSeed(seed) seguido de `stream` saltos */
+void rngStream(Rng* r, uint64_t seed, int stream);
+/* Carril j: rngSeed(seed), `stream` saltos largos y j saltos */
+void rngVecStream(RngVec* v, uint64_t seed, int stream);
+uint64_t rngSeedFromEnv(void);
+
+#endif
@@ -0,0 +1,297 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "roofline.h"
+#include "csvUtils.h"
+#include "hpcbench.h"
+#include "machineInfo.h"
+
+#define CACHE_HEADER "host,cpu,threads,int_gops,flt_gflops,mem_gbs"
+#define CALIBRATION_REPS 3
+
+/* ==========================================
+ * Utilidades
+ * ========================================== */
+int rooflineEnabled(void) {
+    const char* env = getenv("ROOFLINE");
+    return env != NULL && env[0] != '\0' && strcmp(env, "0") != 0;
+}
+
+/* Identidad de la máquina para el caché: host y modelo de CPU (sin comas) */
+static void machineId(char* host, size_t hostLen, char* cpu, size_t cpuLen) {
+    const MachineInfo* mi = machineInfoGet();
+    snprintf(host, hostLen, "%s", mi->host);
+    snprintf(cpu, cpuLen, "%s", mi->cpu_model);
+}
+
+static void cachePath(char* out, size_t len) {
+    const char* env = getenv("ROOFLINE_CACHE");
+    if (env != NULL && env[0] != '\0') {
+        snprintf(out, len, "%s", env);
+        return;
+    }
+    const char* home = getenv("HOME");
+    char dir[480];
+    snprintf(dir, sizeof(dir), "%s/.cache", home ? home : "/tmp");
+    benchEnsureDir(dir);
+    snprintf(out, len, "%s/hpc_roofline.csv", dir);
+}
+
+/* ==========================================
+ * Microbenchmarks de calibración
+ * ==========================================
+ * Vectores explícitos de 64 bytes y varias cadenas independientes para
+ * ocultar la latencia de mul/FMA. target_clones elige la versión según la
+ * CPU en tiempo de ejecución, así el pico no depende de los flags con los
+ * que se compiló el binario que calibra.
+ */
+typedef unsigned IntVec __attribute__((vector_size(64)));
+typedef double FltVec __attribute__((vector_size(64)));
+
+#define PEAK_CHAINS 12
+#define PEAK_ITERS (1L << 22)
+#define INT_LANES (sizeof(IntVec) / sizeof(unsigned))
+#define FLT_LANES (sizeof(FltVec) / sizeof(double))
+
+static volatile unsigned intSink;
+static volatile double fltSink;
+
+__attribute__((target_clones("arch=skylake-avx512", "arch=haswell", "default")))
+static void intPeakKernel(long iters) {
+    IntVec acc[PEAK_CHAINS];
+    IntVec m, c;
+    for (unsigned l = 0; l < INT_LANES; l++) { m[l] = 3u + 2u * l; c[l] = 7u + l; }
+    for (int k = 0; k < PEAK_CHAINS; k++) acc[k] = c + (unsigned)k;
+
+    for (long it = 0; it < iters; it++) {
+        for (int k = 0; k < PEAK_CHAINS; k++) acc[k] = acc[k] * m + c;
+    }
+
+    unsigned r = 0;
+    for (int k = 0; k < PEAK_CHAINS; k++) r += acc[k][0];
+    intSink = r;
+}
+
+__attribute__((target_clones("arch=skylake-avx512", "arch=haswell", "default")))
+static void fltPeakKernel(long iters) {
+    FltVec acc[PEAK_CHAINS];
+    FltVec m, c;
+    for (unsigned l = 0; l < FLT_LANES; l++) { m[l] = 0.999999; c[l] = 1e-7 * (l + 1); }
+    for (int k = 0; k < PEAK_CHAINS; k++) acc[k] = c * (double)(k + 1);
+
+    for (long it = 0; it < iters; it++) {
+        for (int k = 0; k < PEAK_CHAINS; k++) acc[k] = acc[k] * m + c;
+    }
+
+    double r = 0.0;
+    for (int k = 0; k < PEAK_CHAINS; k++) r += acc[k][0];
+    fltSink = r;
+}
+
+/* Triad de STREAM: arreglos muy por encima de la LLC */
+#define STREAM_N (1L << 23)
+
+typedef enum { TASK_INT, TASK_FLT, TASK_STREAM_INIT, TASK_STREAM } CalibrationTask;
+
+typedef struct {
+    CalibrationTask task;
+    int id;
+    int threads;
+    double* a;
+    double* b;
+    double* c;
+} CalibrationArgs;
+
+static void* calibrationWorker(void* arg) {
+    CalibrationArgs* w = (CalibrationArgs*)arg;
+    long lo = STREAM_N * w->id / w->threads;
+    long hi = STREAM_N * (w->id + 1) / w->threads;
+
+    switch (w->task) {
+    case TASK_INT:
+        intPeakKernel(PEAK_ITERS);
+        break;
+    case TASK_FLT:
+        fltPeakKernel(PEAK_ITERS);
+        break;
+    case TASK_STREAM_INIT:
+        /* Primer toque en el hilo que luego usa la porción */
+        for (long i = lo; i < hi; i++) { w->a[i] = 0.0; w->b[i] = 1.0; w->c[i] = 2.0; }
+        break;
+    case TASK_STREAM: {
+        double* restrict a = w->a;
+        const double* restrict b = w->b;
+        const double* restrict c = w->c;
+        for (long i = lo; i < hi; i++) a[i] = b[i] + 3.0 * c[i];
+        break;
+    }
+    }
+    return NULL;
+}
+
+/* Ejecuta la tarea en `threads` hilos y devuelve el tiempo de pared */
+static double runCalibration(CalibrationTask task, int threads, double* a, double* b, double* c) {
+    pthread_t tids[threads];
+    CalibrationArgs args[threads];
+
+    double t0 = benchNow();
+    for (int t = 0; t < threads; t++) {
+        args[t] = (CalibrationArgs){ task, t, threads, a, b, c };
+        if (pthread_create(&tids[t], NULL, calibrationWorker, &args[t]) != 0) {
+            fprintf(stderr, "Error: no se pudo crear el hilo de calibración %d\n", t);
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (int t = 0; t < threads; t++) pthread_join(tids[t], NULL);
+    return benchNow() - t0;
+}
+
+static double bestOf(CalibrationTask task, int threads, double* a, double* b, double* c) {
+    double best = 1e30;
+    for (int r = 0; r < CALIBRATION_REPS; r++) {
+        double t = runCalibration(task, threads, a, b, c);
+        if (t < best) best = t;
+    }
+    return best;
+}
+
+void rooflineCalibrate(RooflinePeaks* peaks, int threads) {
+    if (threads < 1) threads = 1;
+    peaks->threads = threads;
+
+    /* 2 operaciones (mul + add) por carril, por cadena, por iteración */
+    double intOps = 2.0 * PEAK_CHAINS * INT_LANES * PEAK_ITERS * threads;
+    double fltOps = 2.0 * PEAK_CHAINS * FLT_LANES * PEAK_ITERS * threads;
+    peaks->int_gops = intOps / bestOf(TASK_INT, threads, NULL, NULL, NULL) / 1e9;
+    peaks->flt_gflops = fltOps / bestOf(TASK_FLT, threads, NULL, NULL, NULL) / 1e9;
+
+    double* a = (double*)malloc(STREAM_N * sizeof(double));
+    double* b = (double*)malloc(STREAM_N * sizeof(double));
+    double* c = (double*)malloc(STREAM_N * sizeof(double));
+    if (a == NULL || b == NULL || c == NULL) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para la calibración de ancho de banda\n");
+        exit(EXIT_FAILURE);
+    }
+    runCalibration(TASK_STREAM_INIT, threads, a, b, c);
+    /* Convención de STREAM: 2 lecturas + 1 escritura, sin write-allocate */
+    double streamBytes = 3.0 * sizeof(double) * STREAM_N;
+    peaks->mem_gbs = streamBytes / bestOf(TASK_STREAM, threads, a, b, c) / 1e9;
+    free(a);
+    free(b);
+    free(c);
+}
+
+/* ==========================================
+ * Caché por máquina
+ * ========================================== */
+static int readCachedPeaks(const char* path, const char* host, const char* cpu,
+                           int threads, RooflinePeaks* peaks) {
+    FILE* f = fopen(path, "r");
+    if (f == NULL) return 0;
+
+    char line[1024];
+    int found = 0;
+    while (!found && fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\n")] = '\0';
+        char* save = NULL;
+        char* h = strtok_r(line, ",", &save);
+        char* c = strtok_r(NULL, ",", &save);
+        char* t = strtok_r(NULL, ",", &save);
+        char* i = strtok_r(NULL, ",", &save);
+        char* fl = strtok_r(NULL, ",", &save);
+        char* m = strtok_r(NULL, ",", &save);
+        if (!h || !c || !t || !i || !fl || !m) continue;
+        if (strcmp(h, host) != 0 || strcmp(c, cpu) != 0 || atoi(t) != threads) continue;
+        peaks->threads = threads;
+        peaks->int_gops = atof(i);
+        peaks->flt_gflops = atof(fl);
+        peaks->mem_gbs = atof(m);
+        found = peaks->int_gops > 0 && peaks->flt_gflops > 0 && peaks->mem_gbs > 0;
+    }
+    fclose(f);
+    return found;
+}
+
+void rooflineLoadPeaks(RooflinePeaks* peaks, int threads) {
+    if (threads < 1) threads = 1;
+
+    char host[256], cpu[256], path[512];
+    machineId(host, sizeof(host), cpu, sizeof(cpu));
+    cachePath(path, sizeof(path));
+
+    if (readCachedPeaks(path, host, cpu, threads, peaks)) return;
+
+    printf("Calibrando roofline para %s con %d hilos (se guarda en %s)...\n", host, threads, path);
+    rooflineCalibrate(peaks, threads);
+
+    ensureCSVHeader(path, CACHE_HEADER);
+    FILE* f = fopen(path, "a");
+    if (f == NULL) {
+        fprintf(stderr, "Aviso: no se pudo escribir el caché de roofline %s\n", path);
+        return;
+    }
+    fprintf(f, "%s,%s,%d,%.3f,%.3f,%.3f\n", host, cpu, threads,
+            peaks->int_gops, peaks->flt_gflops, peaks->mem_gbs);
+    fclose(f);
+}
+
+/* ==========================================
+ * Reporte por corrida
+ * ========================================== */
+void rooflineReport(const char* dirPath, const char* benchmark, long size, int threads,
+                    RooflineKind kind, double ops, double bytes, const BenchSummary* time,
+                    const PerfCounters* pc) {
+    if (!rooflineEnabled()) return;
+
+    RooflinePeaks peaks;
+    rooflineLoadPeaks(&peaks, threads);
+
+    /* Fallos y tiempo de la misma estadística: con tráfico medido, ambos
+     * promedio por repetición; si no, la mediana como el resto de los CSV */
+    double peakCompute = (kind == ROOFLINE_INT) ? peaks.int_gops : peaks.flt_gflops;
+    double bytesLlc = -1.0;
+    double seconds = time->median;
+    if (pc != NULL && pc->runs > 0 && pc->sum[PERF_LLC_MISSES] >= 0) {
+        bytesLlc = 64.0 * pc->sum[PERF_LLC_MISSES] / pc->runs;
+        seconds = time->mean;
+    }
+
+    /* El tráfico medido manda si existe; si no, el mínimo del modelo */
+    double traffic = (bytesLlc > 0) ? bytesLlc : bytes;
+    double intensity = (traffic > 0) ? ops / traffic : INFINITY;
+    double achieved = (seconds > 1e-12) ? ops / seconds / 1e9 : 0.0;
+    double ridge = peakCompute / peaks.mem_gbs;
+    double attainable = isinf(intensity) ? peakCompute : fmin(peakCompute, intensity * peaks.mem_gbs);
+    double fraction = (attainable > 0) ? achieved / attainable : 0.0;
+    const char* bound = (intensity < ridge) ? "memoria" : "computo";
+
+    printf("\n===== ROOFLINE =====\n");
+    printf("Picos: %.3f %s, %.3f GB/s (punto de quiebre %.3f op/B)\n",
+           peakCompute, kind == ROOFLINE_INT ? "Gop/s enteras" : "GFLOP/s", peaks.mem_gbs, ridge);
+    printf("Intensidad aritmética: %.4f op/B (%s)\n", intensity,
+           bytesLlc > 0 ? "tráfico medido en LLC, promedio por repetición" : "tráfico mínimo del modelo");
+    printf("Logrado: %.6f Gop/s de %.6f alcanzables (%.2f%%), limitado por %s\n",
+           achieved, attainable, 100.0 * fraction, bound);
+
+    benchEnsureDir(dirPath);
+    char filename[512];
+    snprintf(filename, sizeof(filename), "%s/Roofline_Results.csv", dirPath);
+    ensureCSVHeader(filename, ROOFLINE_CSV_HEADER);
+
+    FILE* f = fopen(filename, "a");
+    if (f == NULL) {
+        fprintf(stderr, "Error: no se pudo abrir %s\n", filename);
+        return;
+    }
+    fprintf(f, "%s,%ld,%d,%s,%.0f,%.0f,", benchmark, size, threads,
+            kind == ROOFLINE_INT ? "int" : "float", ops, bytes);
+    if (bytesLlc >= 0) fprintf(f, "%.0f", bytesLlc);
+    fprintf(f, ",%.6f,%.6f,%.3f,%.3f,%.6f,%.6f,%.6f,%s\n",
+            intensity, achieved, peakCompute, peaks.mem_gbs, ridge, attainable, fraction, bound);
+    fclose(f);
+    printf("Roofline guardado en: %s\n", filename);
+}
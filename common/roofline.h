@@ -0,0 +1,54 @@
+#ifndef ROOFLINE_H
+#define ROOFLINE_H
+
+#include "perfCounters.h"
+#include "hpcbench.h"
+
+/* ==========================================
+ * Modelo roofline
+ * ==========================================
+ * Se activa con la variable de entorno ROOFLINE=1 (también sirve
+ * `make run ... ROOFLINE=1`, make la exporta a los binarios).
+ *
+ * La primera vez que se usa en una máquina se calibran los picos con
+ * microbenchmarks propios:
+ *   - enteros: cadenas independientes de mul+add vectoriales (Gop/s)
+ *   - punto flotante: cadenas independientes de FMA en double (GFLOP/s)
+ *   - memoria: triad de STREAM a[i] = b[i] + s*c[i] (GB/s)
+ * y se guardan en un caché por máquina (host + modelo de CPU + hilos):
+ *   $ROOFLINE_CACHE, o si no $HOME/.cache/hpc_roofline.csv
+ * Para recalibrar basta con borrar la fila o el archivo.
+ */
+typedef enum {
+    ROOFLINE_INT = 0,       // operaciones enteras
+    ROOFLINE_FLOAT          // operaciones de punto flotante
+} RooflineKind;
+
+typedef struct {
+    int threads;
+    double int_gops;        // pico de operaciones enteras
+    double flt_gflops;      // pico de operaciones de punto flotante
+    double mem_gbs;         // ancho de banda de memoria (triad)
+} RooflinePeaks;
+
+int rooflineEnabled(void);
+
+/* Lee los picos del caché o los calibra (y guarda) si no están */
+void rooflineLoadPeaks(RooflinePeaks* peaks, int threads);
+void rooflineCalibrate(RooflinePeaks* peaks, int threads);
+
+/* Reporta una corrida: intensidad aritmética, rendimiento alcanzable y
+ * fracción lograda del techo. Agrega una fila a <dirPath>/Roofline_Results.csv.
+ * `bytes` es el tráfico mínimo del modelo; si `pc` acumuló fallos de LLC
+ * (perfCountersAccumulate) se usa el tráfico medido (fallos x 64 B por
+ * repetición) con el tiempo medio de `time`; si no, su mediana.
+ * No hace nada si ROOFLINE no está activo. */
+void rooflineReport(const char* dirPath, const char* benchmark, long size, int threads,
+                    RooflineKind kind, double ops, double bytes, const BenchSummary* time,
+                    const PerfCounters* pc);
+
+#define ROOFLINE_CSV_HEADER \
+    "benchmark,size,threads,kind,ops,bytes_model,bytes_llc,intensity,achieved_gops," \
+    "peak_compute_gops,peak_bandwidth_gbs,ridge_point,attainable_gops,fraction,bound"
+
+#endif
@@ -0,0 +1,331 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/mman.h>
+
+#include "scaling.h"
+#include "csvUtils.h"
+#include "machineInfo.h"
+
+/* Valor ausente en los CSV. No se usa NAN: los binarios se compilan con
+ * -ffast-math, que asume que no hay NaN e isnan() siempre da falso */
+#define NO_VALUE (-1e300)
+#define HAS_VALUE(v) ((v) > -1e299)
+
+/* ==========================================
+ * Tiempos por worker
+ * ========================================== */
+static double* allocTimes(int n, int shared) {
+    double* p;
+    if (shared) {
+        /* Los hijos de fork escriben aquí sus marcas */
+        p = mmap(NULL, n * sizeof(double), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) p = NULL;
+    } else {
+        p = (double*)calloc(n, sizeof(double));
+    }
+    if (p == NULL) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para los tiempos de %d workers\n", n);
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+void workerTimesInit(WorkerTimes* wt, int workers, int shared) {
+    memset(wt, 0, sizeof(*wt));
+    wt->workers = workers;
+    wt->shared = shared;
+    wt->start = allocTimes(workers, shared);
+    wt->end = allocTimes(workers, shared);
+    wt->busy = allocTimes(workers, 0);
+    wt->idle = allocTimes(workers, 0);
+}
+
+void workerTimesJoin(WorkerTimes* wt, const BenchRun* run) {
+    const double join = run->t1;
+    if (benchIsWarmup(run)) return;
+    for (int i = 0; i < wt->workers; i++) {
+        wt->busy[i] += wt->end[i] - wt->start[i];
+        wt->idle[i] += join - wt->end[i];
+    }
+    wt->reps++;
+}
+
+void workerTimesFree(WorkerTimes* wt) {
+    if (wt->shared) {
+        munmap(wt->start, wt->workers * sizeof(double));
+        munmap(wt->end, wt->workers * sizeof(double));
+    } else {
+        free(wt->start);
+        free(wt->end);
+    }
+    free(wt->busy);
+    free(wt->idle);
+    memset(wt, 0, sizeof(*wt));
+}
+
+/* ==========================================
+ * Estudio de escalabilidad
+ * ========================================== */
+void scalingInit(ScalingStudy* sc) {
+    memset(sc, 0, sizeof(*sc));
+}
+
+void scalingAdd(ScalingStudy* sc, const BenchRecord* rec, const BenchRun* run, const WorkerTimes* wt) {
+    if (sc->count == sc->capacity) {
+        sc->capacity = sc->capacity ? 2 * sc->capacity : 16;
+        sc->points = (ScalingPoint*)realloc(sc->points, sc->capacity * sizeof(ScalingPoint));
+        if (sc->points == NULL) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para el estudio de escalabilidad\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    ScalingPoint* p = &sc->points[sc->count++];
+    memset(p, 0, sizeof(*p));
+    p->project = rec->project;
+    p->program = rec->program;
+    snprintf(p->variant, sizeof(p->variant), "%s", rec->variant ? rec->variant : rec->program);
+    p->size = rec->size;
+    p->workers = rec->workers;
+    p->median = run->summary.median;
+    p->mean = run->summary.mean;
+
+    if (wt != NULL && wt->reps > 0 && wt->workers > 0) {
+        p->hasWorkers = 1;
+        double sum = 0.0, idle = 0.0;
+        for (int i = 0; i < wt->workers; i++) {
+            double b = wt->busy[i] / wt->reps;
+            sum += b;
+            idle += wt->idle[i] / wt->reps;
+            if (b > p->busyMax) p->busyMax = b;
+        }
+        p->busyAvg = sum / wt->workers;
+        p->idleAvg = idle / wt->workers;
+    }
+}
+
+static int sameGroup(const ScalingPoint* a, const ScalingPoint* b) {
+    return a->size == b->size && strcmp(a->project, b->project) == 0 &&
+           strcmp(a->program, b->program) == 0 && strcmp(a->variant, b->variant) == 0;
+}
+
+/* Mediana con 1 worker del mismo grupo (NO_VALUE si el barrido no la incluye) */
+static double serialTime(const ScalingStudy* sc, const ScalingPoint* p) {
+    for (int i = 0; i < sc->count; i++)
+        if (sc->points[i].workers == 1 && sameGroup(&sc->points[i], p)) return sc->points[i].median;
+    return NO_VALUE;
+}
+
+static void writeOptional(FILE* f, double v, const char* sep) {
+    if (!HAS_VALUE(v)) fprintf(f, "%s", sep);
+    else fprintf(f, "%.6f%s", v, sep);
+}
+
+static void printOptional(double v) {
+    if (!HAS_VALUE(v)) printf(" %9s", "-");
+    else printf(" %9.3f", v);
+}
+
+/* Resuelve M·x = v (3x3) por eliminación con pivoteo; 0 si es singular */
+static int solve3(double M[3][3], double v[3], double x[3]) {
+    for (int c = 0; c < 3; c++) {
+        int piv = c;
+        for (int r = c + 1; r < 3; r++)
+            if (fabs(M[r][c]) > fabs(M[piv][c])) piv = r;
+        if (fabs(M[piv][c]) < 1e-300) return 0;
+        for (int k = 0; k < 3; k++) {
+            double t = M[c][k]; M[c][k] = M[piv][k]; M[piv][k] = t;
+        }
+        double t = v[c]; v[c] = v[piv]; v[piv] = t;
+        for (int r = c + 1; r < 3; r++) {
+            double f = M[r][c] / M[c][c];
+            for (int k = c; k < 3; k++) M[r][k] -= f * M[c][k];
+            v[r] -= f * v[c];
+        }
+    }
+    for (int r = 2; r >= 0; r--) {
+        double s = v[r];
+        for (int k = r + 1; k < 3; k++) s -= M[r][k] * x[k];
+        x[r] = s / M[r][r];
+    }
+    return 1;
+}
+
+typedef struct {
+    int points;
+    double t1;              // medido (NO_VALUE si falta)
+    double amdahl;          // fracción serial de Amdahl
+    double gustafson;       // fracción serial de Gustafson
+    double a, b, c;         // T(p) = a + b/p + c·p
+    int best;
+    double bestTime;
+} ScalingFit;
+
+/* Ajustes por mínimos cuadrados sobre las medianas de un grupo */
+static int fitGroup(const ScalingStudy* sc, const ScalingPoint* ref, ScalingFit* fit) {
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    int n = 0, pmin = 0, pmax = 0, distinct = 0;
+    for (int i = 0; i < sc->count; i++) {
+        const ScalingPoint* p = &sc->points[i];
+        if (!sameGroup(p, ref) || p->median <= 0) continue;
+        double x = 1.0 / p->workers;
+        sx += x; sy += p->median; sxx += x * x; sxy += x * p->median;
+        if (n == 0 || p->workers < pmin) pmin = p->workers;
+        if (n == 0 || p->workers > pmax) pmax = p->workers;
+        n++;
+    }
+    if (n < 2 || pmin == pmax) return 0;
+    /* Cantidad de valores distintos de p (el modelo con sobrecosto pide 3) */
+    for (int q = pmin; q <= pmax; q++) {
+        for (int i = 0; i < sc->count; i++) {
+            if (sameGroup(&sc->points[i], ref) && sc->points[i].workers == q) { distinct++; break; }
+        }
+    }
+
+    memset(fit, 0, sizeof(*fit));
+    fit->points = n;
+    fit->t1 = serialTime(sc, ref);
+
+    /* Amdahl: T(p) = a + b/p, fracción serial a / (a + b) */
+    double det = n * sxx - sx * sx;
+    fit->b = (n * sxy - sx * sy) / det;
+    fit->a = (sy - fit->b * sx) / n;
+    fit->amdahl = (fit->a + fit->b > 0) ? fit->a / (fit->a + fit->b) : NO_VALUE;
+    if (HAS_VALUE(fit->amdahl)) fit->amdahl = fmin(1.0, fmax(0.0, fit->amdahl));
+
+    /* Gustafson: S(p) = p - s·(p - 1) con S medido contra T1 */
+    fit->gustafson = NO_VALUE;
+    if (HAS_VALUE(fit->t1)) {
+        double num = 0, den = 0;
+        for (int i = 0; i < sc->count; i++) {
+            const ScalingPoint* p = &sc->points[i];
+            if (!sameGroup(p, ref) || p->workers <= 1 || p->median <= 0) continue;
+            double s = fit->t1 / p->median;
+            num += (p->workers - s) * (p->workers - 1);
+            den += (double)(p->workers - 1) * (p->workers - 1);
+        }
+        if (den > 0) fit->gustafson = fmin(1.0, fmax(0.0, num / den));
+    }
+
+    /* Sobrecosto lineal en p: T(p) = a + b/p + c·p (solo si c sale positivo) */
+    if (distinct >= 3) {
+        double M[3][3] = {{0}}, v[3] = {0}, x[3] = {0};
+        for (int i = 0; i < sc->count; i++) {
+            const ScalingPoint* p = &sc->points[i];
+            if (!sameGroup(p, ref) || p->median <= 0) continue;
+            double phi[3] = {1.0, 1.0 / p->workers, (double)p->workers};
+            for (int r = 0; r < 3; r++) {
+                for (int k = 0; k < 3; k++) M[r][k] += phi[r] * phi[k];
+                v[r] += phi[r] * p->median;
+            }
+        }
+        if (solve3(M, v, x) && x[2] > 0) {
+            fit->a = x[0];
+            fit->b = x[1];
+            fit->c = x[2];
+        }
+    }
+
+    /* Mínimo del modelo entre 1 y los hilos de la máquina (o lo medido) */
+    int limit = machineInfoGet()->threads;
+    if (limit < pmax) limit = pmax;
+    fit->best = 1;
+    fit->bestTime = fit->a + fit->b + fit->c;
+    for (int q = 2; q <= limit; q++) {
+        double t = fit->a + fit->b / q + fit->c * q;
+        if (t < fit->bestTime) {
+            fit->best = q;
+            fit->bestTime = t;
+        }
+    }
+    return 1;
+}
+
+static FILE* openCSV(const char* dirPath, const char* name, const char* header) {
+    char filename[512];
+    snprintf(filename, sizeof(filename), "%s/%s", dirPath, name);
+    ensureCSVHeader(filename, header);
+    FILE* f = fopen(filename, "a");
+    if (f == NULL) fprintf(stderr, "Error: no se pudo abrir %s\n", filename);
+    return f;
+}
+
+void scalingFinish(ScalingStudy* sc, const char* dirPath) {
+    if (sc->count == 0) return;
+    benchEnsureDir(dirPath);
+    const char* machineId = machineInfoGet()->machine_id;
+
+    printf("\n===== BALANCE DE CARGA =====\n");
+    printf("%-22s %10s %4s %9s %9s %9s %9s %9s\n",
+           "variante", "N", "p", "desbal.", "util.", "speedup", "efic.", "K-F");
+    FILE* f = openCSV(dirPath, "Parallel_Metrics.csv", PARALLEL_METRICS_CSV_HEADER);
+    for (int i = 0; i < sc->count; i++) {
+        const ScalingPoint* p = &sc->points[i];
+        double imbalance = NO_VALUE, utilization = NO_VALUE;
+        double speedup = NO_VALUE, efficiency = NO_VALUE, karpFlatt = NO_VALUE;
+        if (p->hasWorkers && p->busyAvg > 0) {
+            imbalance = p->busyMax / p->busyAvg;
+            utilization = p->mean > 0 ? p->busyAvg / p->mean : NO_VALUE;
+        }
+        double t1 = serialTime(sc, p);
+        if (HAS_VALUE(t1) && p->median > 0) {
+            speedup = t1 / p->median;
+            efficiency = speedup / p->workers;
+            /* e = (1/S - 1/p) / (1 - 1/p) */
+            if (p->workers > 1)
+                karpFlatt = (1.0 / speedup - 1.0 / p->workers) / (1.0 - 1.0 / p->workers);
+        }
+
+        printf("%-22s %10ld %4d", p->variant, p->size, p->workers);
+        printOptional(imbalance);
+        printOptional(utilization);
+        printOptional(speedup);
+        printOptional(efficiency);
+        printOptional(karpFlatt);
+        putchar('\n');
+        if (f == NULL) continue;
+        fprintf(f, "%s,%s,%s,%ld,%d,%.9f,", p->project, p->program, p->variant,
+                p->size, p->workers, p->median);
+        writeOptional(f, p->hasWorkers ? p->busyAvg : NO_VALUE, ",");
+        writeOptional(f, p->hasWorkers ? p->busyMax : NO_VALUE, ",");
+        writeOptional(f, p->hasWorkers ? p->idleAvg : NO_VALUE, ",");
+        writeOptional(f, imbalance, ",");
+        writeOptional(f, utilization, ",");
+        writeOptional(f, speedup, ",");
+        writeOptional(f, efficiency, ",");
+        writeOptional(f, karpFlatt, ",");
+        fprintf(f, "%s\n", machineId);
+    }
+    if (f != NULL) fclose(f);
+
+    /* Un ajuste por (programa, variante, tamaño) con al menos dos valores de p */
+    FILE* fits = NULL;
+    for (int i = 0; i < sc->count; i++) {
+        int seen = 0;
+        for (int j = 0; j < i && !seen; j++) seen = sameGroup(&sc->points[j], &sc->points[i]);
+        ScalingFit fit;
+        if (seen || !fitGroup(sc, &sc->points[i], &fit)) continue;
+
+        const ScalingPoint* p = &sc->points[i];
+        if (fits == NULL) {
+            fits = openCSV(dirPath, "Scaling_Fit.csv", SCALING_FIT_CSV_HEADER);
+            printf("\n===== ESCALABILIDAD (Amdahl / Gustafson) =====\n");
+        }
+        printf("%s N=%ld: serial Amdahl %.4f", p->variant, p->size, fit.amdahl);
+        if (HAS_VALUE(fit.gustafson)) printf(" | Gustafson %.4f", fit.gustafson);
+        if (fit.c > 0) printf(" | sobrecosto %.3g s/worker", fit.c);
+        printf(" -> mejor: %d workers (%.6f s estimado)\n", fit.best, fit.bestTime);
+
+        if (fits == NULL) continue;
+        fprintf(fits, "%s,%s,%s,%ld,%d,", p->project, p->program, p->variant, p->size, fit.points);
+        writeOptional(fits, fit.t1, ",");
+        writeOptional(fits, fit.amdahl, ",");
+        writeOptional(fits, fit.gustafson, ",");
+        fprintf(fits, "%.9f,%d,%.9f,%s\n", fit.c, fit.best, fit.bestTime, machineId);
+    }
+    if (fits != NULL) fclose(fits);
+
+    free(sc->points);
+    memset(sc, 0, sizeof(*sc));
+}
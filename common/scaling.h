@@ -0,0 +1,82 @@
+#ifndef SCALING_H
+#define SCALING_H
+
+#include "hpcbench.h"
+
+/* ==========================================
+ * Balance de carga y escalabilidad
+ * ==========================================
+ * Cada worker anota cuándo empieza y termina su parte; el hilo principal
+ * cierra la repetición después de benchStop, fuera de la región medida (la
+ * espera se cuenta hasta el fin de la región, que benchStop guarda):
+ *
+ *   WorkerTimes wt;
+ *   workerTimesInit(&wt, workers, 0);   // 1 si los workers son procesos (fork)
+ *   while (benchRunNext(&run)) {
+ *       benchStart(&run);
+ *       ...worker i: wt.start[i] = benchNow(); ...trabajo...; wt.end[i] = benchNow();
+ *       ...join...
+ *       benchStop(&run);
+ *       workerTimesJoin(&wt, &run);     // ignora los calentamientos
+ *   }
+ *
+ * Por worker: tiempo ocupado (end - start) y espera en el join (join - end).
+ *
+ * ScalingStudy junta las configuraciones de un barrido y al final escribe
+ *   Parallel_Metrics.csv: desbalance (máx/promedio del tiempo ocupado),
+ *       utilización, speedup, eficiencia y fracción serial de Karp-Flatt
+ *       (las tres últimas solo si el barrido incluye 1 worker del mismo N)
+ *   Scaling_Fit.csv: por tamaño, ajuste de Amdahl T(p) = a + b/p, fracción
+ *       serial de Gustafson y el modelo con sobrecosto T(p) = a + b/p + c·p,
+ *       cuyo mínimo es la cantidad de workers recomendada para ese N.
+ */
+typedef struct {
+    int workers;
+    int reps;               // repeticiones acumuladas
+    int shared;             // start/end en memoria compartida (procesos)
+    double* start;          // marcas de la repetición en curso (benchNow)
+    double* end;
+    double* busy;           // suma sobre repeticiones, por worker
+    double* idle;
+} WorkerTimes;
+
+void workerTimesInit(WorkerTimes* wt, int workers, int shared);
+/* Después de benchStop */
+void workerTimesJoin(WorkerTimes* wt, const BenchRun* run);
+void workerTimesFree(WorkerTimes* wt);
+
+typedef struct {
+    const char* project;
+    const char* program;
+    char variant[32];
+    long size;
+    int workers;
+    double median;          // mediana del tiempo de pared (s)
+    double mean;            // media (misma base que busyAvg para la utilización)
+    int hasWorkers;         // 0 si no hubo WorkerTimes (kernels sin instrumentar)
+    double busyAvg;         // por repetición
+    double busyMax;
+    double idleAvg;
+} ScalingPoint;
+
+typedef struct {
+    int count;
+    int capacity;
+    ScalingPoint* points;
+} ScalingStudy;
+
+void scalingInit(ScalingStudy* sc);
+/* wt puede ser NULL: la fila queda sin desbalance ni utilización */
+void scalingAdd(ScalingStudy* sc, const BenchRecord* rec, const BenchRun* run, const WorkerTimes* wt);
+/* Escribe los dos CSV en dirPath, imprime el resumen y libera el estudio */
+void scalingFinish(ScalingStudy* sc, const char* dirPath);
+
+#define PARALLEL_METRICS_CSV_HEADER \
+    "project,program,variant,size,workers,median_s,busy_avg_s,busy_max_s,idle_avg_s," \
+    "imbalance,utilization,speedup,efficiency,karp_flatt,machine_id"
+
+#define SCALING_FIT_CSV_HEADER \
+    "project,program,variant,size,points,t1_s,amdahl_serial,gustafson_serial," \
+    "overhead_s_per_worker,best_workers,best_time_s,machine_id"
+
+#endif
@@ -0,0 +1,211 @@
+#ifdef HPC_TRACE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "trace.h"
+
+#define TRACE_MAX_SLOTS 256
+#define TRACE_EVENTS_PER_SLOT (1 << 15)     // 32768 eventos x 24 B por hilo
+
+typedef struct {
+    uint64_t tsc;
+    const char* name;
+    long arg;
+} TraceEventRec;
+
+/* Un buffer por hilo vivo. Cuando un hilo termina su buffer queda libre y
+ * lo toma el siguiente hilo que se cree: en la traza son la misma fila,
+ * pero sus eventos no se solapan en el tiempo. */
+typedef struct {
+    TraceEventRec* events;
+    char* phases;
+    uint64_t count;         // eventos escritos (puede superar la capacidad)
+    int inUse;
+    char name[48];
+} TraceSlot;
+
+static TraceSlot slots[TRACE_MAX_SLOTS];
+static int nslots = 0;
+static pthread_mutex_t slotsLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t slotKey;
+static pthread_once_t initOnce = PTHREAD_ONCE_INIT;
+static __thread TraceSlot* mySlot = NULL;
+static __thread int slotless = 0;
+
+static pid_t ownerPid;
+static uint64_t tsc0;
+static double mono0;
+static long dropped = 0;
+
+/* ==========================================
+ * Reloj
+ * ========================================== */
+static inline uint64_t readTsc(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static double monoSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* ==========================================
+ * Registro de hilos (fuera del camino caliente)
+ * ========================================== */
+static void releaseSlot(void* p) {
+    TraceSlot* s = (TraceSlot*)p;
+    pthread_mutex_lock(&slotsLock);
+    s->inUse = 0;
+    pthread_mutex_unlock(&slotsLock);
+}
+
+static void dumpAtExit(void) {
+    /* Los hijos de fork heredan el atexit: solo vuelca el proceso original */
+    if (getpid() != ownerPid) return;
+    const char* path = getenv("TRACE_FILE");
+    traceDump(path != NULL && path[0] != '\0' ? path : "trace.json");
+}
+
+static void traceInit(void) {
+    pthread_key_create(&slotKey, releaseSlot);
+    ownerPid = getpid();
+    mono0 = monoSeconds();
+    tsc0 = readTsc();
+    atexit(dumpAtExit);
+}
+
+static TraceSlot* acquireSlot(void) {
+    pthread_once(&initOnce, traceInit);
+    TraceSlot* s = NULL;
+    pthread_mutex_lock(&slotsLock);
+    for (int i = 0; i < nslots && s == NULL; i++)
+        if (!slots[i].inUse) s = &slots[i];
+    if (s == NULL && nslots < TRACE_MAX_SLOTS) s = &slots[nslots++];
+    if (s != NULL) {
+        s->inUse = 1;
+        if (s->events == NULL) {
+            s->events = malloc(TRACE_EVENTS_PER_SLOT * sizeof(TraceEventRec));
+            s->phases = malloc(TRACE_EVENTS_PER_SLOT);
+            if (s->events == NULL || s->phases == NULL) {
+                fprintf(stderr, "Error: sin memoria para el buffer de trazas\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        /* Nombre por defecto; TRACE_THREAD_NAME lo reemplaza */
+        if ((pid_t)syscall(SYS_gettid) == ownerPid) snprintf(s->name, sizeof(s->name), "principal");
+        else snprintf(s->name, sizeof(s->name), "fila %d", (int)(s - slots));
+    }
+    pthread_mutex_unlock(&slotsLock);
+
+    if (s == NULL) {
+        slotless = 1;           // demasiados hilos: este no se traza
+        return NULL;
+    }
+    pthread_setspecific(slotKey, s);
+    return s;
+}
+
+/* ==========================================
+ * Camino caliente
+ * ========================================== */
+void traceEvent(const char* name, char phase, long arg) {
+    TraceSlot* s = mySlot;
+    if (__builtin_expect(s == NULL, 0)) {
+        if (slotless) {
+            __atomic_add_fetch(&dropped, 1, __ATOMIC_RELAXED);
+            return;
+        }
+        s = mySlot = acquireSlot();
+        if (s == NULL) return;
+    }
+    uint64_t i = s->count & (TRACE_EVENTS_PER_SLOT - 1);
+    s->events[i].tsc = readTsc();
+    s->events[i].name = name;
+    s->events[i].arg = arg;
+    s->phases[i] = phase;
+    s->count++;
+}
+
+void traceThreadName(const char* fmt, ...) {
+    TraceSlot* s = mySlot;
+    if (s == NULL) {
+        if (slotless) return;
+        s = mySlot = acquireSlot();
+        if (s == NULL) return;
+    }
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(s->name, sizeof(s->name), fmt, ap);
+    va_end(ap);
+}
+
+/* ==========================================
+ * Volcado JSON
+ * ========================================== */
+void traceDump(const char* path) {
+    pthread_once(&initOnce, traceInit);
+
+    /* Ticks por microsegundo medidos entre el inicio y ahora */
+    double elapsed = monoSeconds() - mono0;
+    uint64_t ticks = readTsc() - tsc0;
+    double ticksPerUs = (elapsed > 0 && ticks > 0) ? ticks / (elapsed * 1e6) : 1e3;
+
+    FILE* f = fopen(path, "w");
+    if (f == NULL) {
+        fprintf(stderr, "Error: no se pudo crear la traza %s\n", path);
+        return;
+    }
+    fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"pid %d\"}}",
+            (int)ownerPid, (int)ownerPid);
+
+    long total = 0, overwritten = 0;
+    pthread_mutex_lock(&slotsLock);
+    for (int t = 0; t < nslots; t++) {
+        TraceSlot* s = &slots[t];
+        if (s->count == 0) continue;
+        fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                (int)ownerPid, t, s->name);
+
+        uint64_t n = s->count < TRACE_EVENTS_PER_SLOT ? s->count : TRACE_EVENTS_PER_SLOT;
+        uint64_t first = s->count - n;
+        overwritten += (long)first;
+        for (uint64_t k = first; k < s->count; k++) {
+            const TraceEventRec* e = &s->events[k & (TRACE_EVENTS_PER_SLOT - 1)];
+            double ts = (double)(int64_t)(e->tsc - tsc0) / ticksPerUs;
+            fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%d,\"tid\":%d",
+                    e->name, s->phases[k & (TRACE_EVENTS_PER_SLOT - 1)], ts, (int)ownerPid, t);
+            if (e->arg != TRACE_NO_ARG) fprintf(f, ",\"args\":{\"i\":%ld}", e->arg);
+            fputc('}', f);
+            total++;
+        }
+    }
+    pthread_mutex_unlock(&slotsLock);
+
+    fprintf(f, "\n]}\n");
+    fclose(f);
+    printf("Traza guardada en: %s (%ld eventos", path, total);
+    if (overwritten > 0) printf(", %ld sobrescritos", overwritten);
+    if (dropped > 0) printf(", %ld descartados", dropped);
+    printf(")\n");
+}
+
+#endif
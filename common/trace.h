@@ -0,0 +1,49 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+/* ==========================================
+ * Trazas por hilo (formato Chrome trace)
+ * ==========================================
+ * Se compila solo con -DHPC_TRACE (make all TRACE=1); sin esa bandera las
+ * macros no generan código y trace.c queda vacío.
+ *
+ * Cada hilo escribe en su propio buffer circular (sin locks en el camino
+ * caliente) marcas de inicio/fin tomadas con el TSC. Al salir el proceso
+ * se vuelca todo a $TRACE_FILE (por defecto trace.json), que se abre en
+ * chrome://tracing o en https://ui.perfetto.dev.
+ *
+ *   TRACE_THREAD_NAME("hilo %d", id);   // nombre de la fila (opcional)
+ *   TRACE_BEGIN("worker");
+ *   TRACE_BEGIN_ARG("chunk", inicio);   // el argumento aparece en args.i
+ *   ...
+ *   TRACE_END("chunk");
+ *   TRACE_END("worker");
+ *
+ * Los nombres deben ser literales (se guarda el puntero, no una copia).
+ * Si un buffer se llena se pisan los eventos más viejos. Los hilos que ya
+ * terminaron ceden su buffer (y su fila en la traza) al siguiente que se
+ * cree; la fila queda con el último nombre, por eso los workers pasan su id
+ * como argumento.
+ */
+#ifdef HPC_TRACE
+
+void traceEvent(const char* name, char phase, long arg);
+void traceThreadName(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+void traceDump(const char* path);
+
+#define TRACE_NO_ARG (-1L)
+#define TRACE_BEGIN(name)           traceEvent((name), 'B', TRACE_NO_ARG)
+#define TRACE_BEGIN_ARG(name, arg)  traceEvent((name), 'B', (long)(arg))
+#define TRACE_END(name)             traceEvent((name), 'E', TRACE_NO_ARG)
+#define TRACE_THREAD_NAME(...)      traceThreadName(__VA_ARGS__)
+
+#else
+
+#define TRACE_BEGIN(name)           ((void)0)
+#define TRACE_BEGIN_ARG(name, arg)  ((void)0)
+#define TRACE_END(name)             ((void)0)
+#define TRACE_THREAD_NAME(...)      ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,99 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "workQueue.h"
+
+static size_t queueBytes(int workers) {
+    return sizeof(WorkQueue) + (size_t)workers * sizeof(WorkSlot);
+}
+
+static long envChunk(void) {
+    const char* v = getenv("WORK_CHUNK");
+    if (v == NULL || *v == '\0') return 0;
+    char* end;
+    long x = strtol(v, &end, 10);
+    if (end == v || *end != '\0' || x < 1) {
+        fprintf(stderr, "Error: WORK_CHUNK=%s inválido (índices por bloque, mínimo 1)\n", v);
+        exit(EXIT_FAILURE);
+    }
+    return x;
+}
+
+static int envDynamic(void) {
+    const char* v = getenv("WORK_SCHED");
+    if (v == NULL || *v == '\0' || strcmp(v, "dinamico") == 0) return 1;
+    if (strcmp(v, "estatico") == 0) return 0;
+    fprintf(stderr, "Error: WORK_SCHED=%s inválido (dinamico o estatico)\n", v);
+    exit(EXIT_FAILURE);
+}
+
+WorkQueue* workQueueCreate(int workers) {
+    WorkQueue* q = mmap(NULL, queueBytes(workers), PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (q == MAP_FAILED) {
+        perror("mmap");
+        exit(EXIT_FAILURE);
+    }
+    q->capacity = workers;
+    q->dynamic = envDynamic();
+    q->fixedChunk = envChunk();
+    workQueueReset(q, workers, 0);
+    return q;
+}
+
+void workQueueReset(WorkQueue* q, int workers, long total) {
+    if (workers < 1 || workers > q->capacity) {
+        fprintf(stderr, "Error: %d workers en una cola creada para %d\n", workers, q->capacity);
+        exit(EXIT_FAILURE);
+    }
+    q->workers = workers;
+    q->total = total;
+    q->chunk = q->fixedChunk;
+    if (q->chunk == 0) {
+        q->chunk = total / ((long)WORK_CHUNKS_PER_WORKER * q->workers);
+        if (q->chunk < WORK_CHUNK_MIN) q->chunk = WORK_CHUNK_MIN;
+    }
+    q->next = 0;
+    memset(q->slots, 0, (size_t)q->workers * sizeof(WorkSlot));
+}
+
+int workQueueClaim(WorkQueue* q, int worker, long* begin, long* end) {
+    WorkSlot* s = &q->slots[worker];
+    long b, e;
+    if (q->dynamic) {
+        b = __atomic_fetch_add(&q->next, q->chunk, __ATOMIC_RELAXED);
+        if (b >= q->total) return 0;
+        e = b + q->chunk < q->total ? b + q->chunk : q->total;
+    } else {
+        /* Rango contiguo que cubre [0, total) completo entre todos */
+        if (s->chunks > 0) return 0;
+        b = q->total * worker / q->workers;
+        e = q->total * (worker + 1) / q->workers;
+    }
+    s->claimed += e - b;
+    s->chunks++;
+    *begin = b;
+    *end = e;
+    return 1;
+}
+
+void workQueuePrint(const WorkQueue* q) {
+    long lo = q->slots[0].claimed, hi = lo, sum = 0;
+    for (int i = 0; i < q->workers; i++) {
+        const long c = q->slots[i].claimed;
+        if (c < lo) lo = c;
+        if (c > hi) hi = c;
+        sum += c;
+    }
+    if (q->dynamic) printf("Reparto dinámico en bloques de %ld: ", q->chunk);
+    else printf("Reparto estático: ");
+    printf("%ld de %ld índices, máx/mín por worker %.3f\n", sum, q->total, lo > 0 ? (double)hi / lo : 0.0);
+    for (int i = 0; i < q->workers; i++)
+        printf("  worker %d: %ld índices en %ld bloques\n", i, q->slots[i].claimed, q->slots[i].chunks);
+}
+
+void workQueueFree(WorkQueue* q) {
+    if (q != NULL) munmap(q, queueBytes(q->capacity));
+}
@@ -0,0 +1,57 @@
+#ifndef WORK_QUEUE_H
+#define WORK_QUEUE_H
+
+/* ==========================================
+ * Reparto dinámico de [0, total) entre workers
+ * ==========================================
+ * Un contador atómico en memoria compartida del que cada worker reclama
+ * bloques de índices hasta agotarlo: los workers rápidos (núcleos grandes,
+ * sin vecinos ruidosos) se llevan más bloques y ninguno queda esperando a
+ * uno lento con un tramo fijo. Todo vive en un mmap compartido, así que
+ * sirve igual para hilos y para hijos de fork, que heredan el mapeo.
+ *
+ *   WorkQueue* q = workQueueCreate(maxWorkers);
+ *   while (benchRunNext(&run)) {
+ *       workQueueReset(q, workers, N);            // antes de lanzar, workers <= maxWorkers
+ *       ...worker i: long b, e;
+ *                    while (workQueueClaim(q, i, &b, &e)) ...índices [b, e)...
+ *   }
+ *   workQueuePrint(q);                            // índices por worker
+ *
+ * WORK_SCHED=estatico vuelve al tramo contiguo fijo por worker (una sola
+ * reclamación) para comparar. WORK_CHUNK fija el tamaño del bloque; por
+ * defecto es total / (WORK_CHUNKS_PER_WORKER · workers), con un mínimo de
+ * WORK_CHUNK_MIN para que el contador no se vuelva el cuello de botella.
+ * Los conteos por worker son los de la última repetición. Una misma cola
+ * sirve para todas las configuraciones de un barrido (la crea el padre
+ * antes de un pool de procesos y los hijos la heredan).
+ */
+#define WORK_CHUNKS_PER_WORKER 64
+#define WORK_CHUNK_MIN 4096L
+
+/* Una línea de caché por worker: los contadores no se comparten */
+typedef struct {
+    long claimed;           // índices reclamados
+    long chunks;            // bloques reclamados
+} __attribute__((aligned(64))) WorkSlot;
+
+typedef struct {
+    int capacity;           // slots reservados
+    int workers;            // los de la repetición en curso
+    int dynamic;            // 0 con WORK_SCHED=estatico
+    long fixedChunk;        // WORK_CHUNK (0: automático)
+    long total;
+    long chunk;
+    long next __attribute__((aligned(64)));     // primer índice sin reclamar (atómico)
+    WorkSlot slots[];
+} WorkQueue;
+
+WorkQueue* workQueueCreate(int workers);
+void workQueueReset(WorkQueue* q, int workers, long total);
+/* Siguiente bloque del worker en [*begin, *end); 0 cuando no queda nada */
+int workQueueClaim(WorkQueue* q, int worker, long* begin, long* end);
+/* Índices y bloques por worker, con la relación máx/mín */
+void workQueuePrint(const WorkQueue* q);
+void workQueueFree(WorkQueue* q);
+
+#endif
@@ -1,10 +1,12 @@
+/* Compilar: gcc -O2 -I../common hilos.c ../common/hpcbench.c ../common/csvUtils.c ../common/machineInfo.c ../common/memTrack.c -o hilos -lm -pthread */
+
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <time.h>
 #include <pthread.h>
-#include <sys/time.h>
-#include <sys/resource.h>
+
+#include "hpcbench.h"
 
 // Número de hilos global
 #define NUM_THREADS 2
@@ -90,48 +92,49 @@ int main(int argc, char *argv[]) {
     llenarMatrix(A, n);
     llenarMatrix(B, n);
 
-    // ===== SOLO TIEMPO DE MULTIPLICACIÓN =====
-    struct rusage usage_start, usage_end;
-    getrusage(RUSAGE_SELF, &usage_start);
-    clock_t start = clock();
+    BenchConfig benchConfig;
+    benchConfigInit(&benchConfig);
 
-    // Crear hilos para la multiplicación
     thread_data data[NUM_THREADS];
     int filas_por_hilo = n / NUM_THREADS;
 
-    for (int t = 0; t < NUM_THREADS; t++) {
-        data[t].A = A;
-        data[t].B = B;
-        data[t].C = C;
-        data[t].n = n;
-        data[t].fila_inicio = t * filas_por_hilo;
-        // Último hilo toma las filas sobrantes
-        data[t].fila_fin = (t == NUM_THREADS - 1) ? n : (t + 1) * filas_por_hilo;
+    // ===== SOLO TIEMPO DE MULTIPLICACIÓN =====
+    BenchRun run;
+    benchRunInit(&run, &benchConfig);
+    while (benchRunNext(&run)) {
+        benchStart(&run);
+
+        // Crear hilos para la multiplicación
+        for (int t = 0; t < NUM_THREADS; t++) {
+            data[t].A = A;
+            data[t].B = B;
+            data[t].C = C;
+            data[t].n = n;
+            data[t].fila_inicio = t * filas_por_hilo;
+            // Último hilo toma las filas sobrantes
+            data[t].fila_fin = (t == NUM_THREADS - 1) ? n : (t + 1) * filas_por_hilo;
+
+            pthread_create(&threads[t], NULL, multiplicar_parcial, &data[t]);
+        }
 
-        pthread_create(&threads[t], NULL, multiplicar_parcial, &data[t]);
-    }
+        // Esperar a los hilos
+        for (int t = 0; t < NUM_THREADS; t++) {
+            pthread_join(threads[t], NULL);
+        }
 
-    // Esperar a los hilos
-    for (int t = 0; t < NUM_THREADS; t++) {
-        pthread_join(threads[t], NULL);
+        benchStop(&run);
     }
-
-    clock_t end = clock();
-    getrusage(RUSAGE_SELF, &usage_end);
+    benchRunFinish(&run);
     // ===== FIN DE TIEMPO DE MULTIPLICACIÓN =====
 
-    // Calcular tiempo de CPU
-    double cpu_time_used = ((double)(end - start)) / CLOCKS_PER_SEC;
-
-    // Calcular tiempo de usuario y sistema
-    double user_time = (usage_end.ru_utime.tv_sec - usage_start.ru_utime.tv_sec) +
-                       (usage_end.ru_utime.tv_usec - usage_start.ru_utime.tv_usec) / 1e6;
-    double sys_time = (usage_end.ru_stime.tv_sec - usage_start.ru_stime.tv_sec) +
-                      (usage_end.ru_stime.tv_usec - usage_start.ru_stime.tv_usec) / 1e6;
+    printf("Tiempo real (multiplicación): %f segundos\n", run.summary.median);
+    printf("Tiempo de usuario (multiplicación): %f segundos\n", run.user_time);
+    printf("Tiempo de sistema (multiplicación): %f segundos\n", run.system_time);
+    benchPrintSummary(&run);
 
-    printf("Tiempo de CPU usado (multiplicación): %f segundos\n", cpu_time_used);
-    printf("Tiempo de usuario (multiplicación): %f segundos\n", user_time);
-    printf("Tiempo de sistema (multiplicación): %f segundos\n", sys_time);
+    BenchRecord record = {"pruebas", "hilos", "hilos", n, NUM_THREADS, 2.0 * n * n * (double)n};
+    benchWriteUnified(".", &record, &run);
+    benchRunFree(&run);
 
     // Verificar multiplicación en 5 posiciones aleatorias
     verificarMultiplicacion(A, B, C, n, 5);
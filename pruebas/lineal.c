@@ -1,8 +1,12 @@
+/* Compilar: gcc -O2 -I../common lineal.c ../common/hpcbench.c ../common/csvUtils.c ../common/machineInfo.c ../common/memTrack.c -o lineal -lm -pthread */
+
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <time.h>
 
+#include "hpcbench.h"
+
 // Función para llenar matriz con enteros aleatorios
 void llenarMatrix(int32_t **matrix, int n) {
     for (int i = 0; i < n; i++) {
@@ -51,18 +55,27 @@ int main(int argc, char *argv[]) {
     // Llenar y multiplicar
     llenarMatrix(A, n);
     llenarMatrix(B, n);
-  // Medir el tiempo de multiplicación de matrices
-    clock_t start = clock();
 
-    // Realizar la multiplicación
-    multiplicarMatrix(A, B, C, n);
+    BenchConfig benchConfig;
+    benchConfigInit(&benchConfig);
 
-    clock_t end = clock();
+    // Medir el tiempo de multiplicación de matrices
+    BenchRun run;
+    benchRunInit(&run, &benchConfig);
+    while (benchRunNext(&run)) {
+        benchStart(&run);
+        multiplicarMatrix(A, B, C, n);
+        benchStop(&run);
+    }
+    benchRunFinish(&run);
 
-    // Calcular el tiempo de CPU utilizado
-    double cpu_time_used = ((double)(end - start)) / CLOCKS_PER_SEC;
-    printf("Tiempo de CPU usado para la multiplicación: %f segundos\n", cpu_time_used);
+    printf("Tiempo real de la multiplicación: %f segundos\n", run.summary.median);
+    printf("Tiempo de CPU usado para la multiplicación: %f segundos\n", run.user_time + run.system_time);
+    benchPrintSummary(&run);
 
+    BenchRecord record = {"pruebas", "lineal", "lineal", n, 1, 2.0 * n * n * (double)n};
+    benchWriteUnified(".", &record, &run);
+    benchRunFree(&run);
 
     // Liberar memoria
     for (int i = 0; i < n; i++) {
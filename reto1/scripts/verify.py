@@ -32,7 +32,8 @@ def main():
     fails = []
     for exe in sorted(os.listdir(BIN_DIR)):
         path = os.path.join(BIN_DIR, exe)
-        if not os.access(path, os.X_OK):
+        # bin/montecarlo recibe problema y backend: se prueba a través de los demás
+        if not os.access(path, os.X_OK) or not (exe.endswith("_dartboard") or exe.endswith("_needles")):
             continue
         pi_est, err = run_and_check(path)
         if pi_est is None:
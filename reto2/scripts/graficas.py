@@ -1,4 +1,5 @@
 import os
+import numpy as np
 import pandas as pd
 import matplotlib.pyplot as plt
 
@@ -143,4 +144,37 @@ for metodo in ["Dartboard", "Needles"]:
     if data_openmp:
         graficar_comparacion(metodo, data_seq, data_openmp, "openmp")
     else:
-        print(f"ℹ No hay datos de openmp para {metodo}")
\ No newline at end of file
+        print(f"ℹ No hay datos de openmp para {metodo}")
+
+# ================== ROOFLINE ==================
+def graficar_roofline(csv_path):
+    """Roofline de las corridas hechas con ROOFLINE=1 (una gráfica por número de workers)."""
+    if not os.path.exists(csv_path):
+        print(f"ℹ No hay datos de roofline en {csv_path}")
+        return
+    df = pd.read_csv(csv_path)
+    for workers, grupo in df.groupby("threads"):
+        pico = grupo["peak_compute_gops"].iloc[-1]
+        banda = grupo["peak_bandwidth_gbs"].iloc[-1]
+        x = np.logspace(-2, 3, 200)
+
+        plt.figure(figsize=(9, 6))
+        plt.loglog(x, np.minimum(pico, x * banda), 'k-', linewidth=2,
+                   label=f"Techo ({pico:.1f} GFLOP/s, {banda:.1f} GB/s)")
+        for programa, puntos in grupo.groupby("benchmark"):
+            # Monte Carlo no toca memoria: intensidad infinita, se dibuja al borde
+            intensidad = puntos["intensity"].replace(np.inf, x[-1])
+            plt.loglog(intensidad, puntos["achieved_gops"], 'o', label=programa)
+
+        plt.title(f"Roofline ({workers} workers)")
+        plt.xlabel("Intensidad aritmética (FLOP/B)")
+        plt.ylabel("Rendimiento (GFLOP/s)")
+        plt.legend(fontsize=8)
+        plt.grid(True, which="both", alpha=0.3)
+        plt.tight_layout()
+        out_file = os.path.join(OUTPUT_DIR, f"roofline_{workers}workers.png")
+        plt.savefig(out_file, dpi=300)
+        plt.close()
+        print(f"✅ Guardado {out_file}")
+
+graficar_roofline(os.path.join("results", "roofline", "Roofline_Results.csv"))
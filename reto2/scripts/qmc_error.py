@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""Error frente a tiempo: PRNG (MC_KERNEL=escalar) contra Sobol y Halton.
+
+Para cada N corre R réplicas con semillas distintas (RNG_SEED); con QMC
+aleatorizado cada semilla es una réplica independiente, así que el error
+estándar sale de la dispersión entre réplicas como en Monte Carlo.
+
+Uso: python3 scripts/qmc_error.py [prog] [workers] [réplicas]
+     (por defecto hilos 4 8; prog sin sufijo: se corren _dartboard y _needles)
+"""
+import csv, math, os, re, statistics, subprocess, sys
+
+BIN_DIR = "bin"
+OUT_DIR = "results"
+OUT_CSV = os.path.join(OUT_DIR, "QMC_Error.csv")
+KERNELS = ["escalar", "sobol", "halton"]
+SIZES = [10**4, 10**5, 10**6, 10**7]
+
+PI_RE = re.compile(r"PI.*?:\s*([0-9]+\.[0-9]+)", re.IGNORECASE)
+TIME_RE = re.compile(r"Tiempo (?:real|de usuario):\s*([0-9.eE+-]+)")
+
+def run(exe, n, workers, kernel, seed):
+    args = [exe, str(n)] if "secuencial" in exe else [exe, str(n), str(workers)]
+    env = dict(os.environ, MC_KERNEL=kernel, RNG_SEED=str(seed),
+               BENCH_REPS="1", BENCH_WARMUP="0")
+    env.pop("MC_TOL", None)
+    out = subprocess.check_output(args, text=True, env=env, stderr=subprocess.DEVNULL)
+    pi, t = PI_RE.search(out), TIME_RE.search(out)
+    if not pi or not t:
+        raise RuntimeError(f"salida inesperada de {exe}:\n{out}")
+    return float(pi.group(1)), float(t.group(1))
+
+def main():
+    prog = sys.argv[1] if len(sys.argv) > 1 else "hilos"
+    workers = int(sys.argv[2]) if len(sys.argv) > 2 else 4
+    reps = int(sys.argv[3]) if len(sys.argv) > 3 else 8
+    if reps < 2:
+        print("Error: se necesitan al menos 2 réplicas para estimar el error")
+        sys.exit(1)
+
+    rows = []
+    for alg in ("dartboard", "needles"):
+        exe = os.path.join(BIN_DIR, f"{prog}_{alg}")
+        if not os.access(exe, os.X_OK):
+            print(f"No existe {exe}. Primero compila con 'make all'")
+            sys.exit(1)
+        for kernel in KERNELS:
+            for n in SIZES:
+                runs = [run(exe, n, workers, kernel, 1000 + r) for r in range(reps)]
+                pis = [p for p, _ in runs]
+                rows.append({
+                    "Algoritmo": alg, "Kernel": kernel, "N": n,
+                    "Workers": 1 if "secuencial" in exe else workers, "Replicas": reps,
+                    "Pi_Medio": statistics.fmean(pis),
+                    "RMSE": math.sqrt(statistics.fmean((p - math.pi) ** 2 for p in pis)),
+                    "Error_Estandar": statistics.stdev(pis) / math.sqrt(reps),
+                    "Tiempo_s": statistics.median(t for _, t in runs),
+                })
+
+    os.makedirs(OUT_DIR, exist_ok=True)
+    with open(OUT_CSV, "w", newline="") as f:
+        w = csv.DictWriter(f, fieldnames=list(rows[0].keys()))
+        w.writeheader()
+        w.writerows(rows)
+
+    print(f"{'algoritmo':<10} {'kernel':<8} {'N':>10} {'RMSE':>11} {'err. est.':>11} {'tiempo (s)':>11}")
+    for r in rows:
+        print(f"{r['Algoritmo']:<10} {r['Kernel']:<8} {r['N']:>10} {r['RMSE']:>11.3e} "
+              f"{r['Error_Estandar']:>11.3e} {r['Tiempo_s']:>11.6f}")
+    print(f"\nGuardado en: {OUT_CSV}")
+
+    try:
+        import matplotlib.pyplot as plt
+    except ImportError:
+        print("Info: sin matplotlib, no se grafica")
+        return
+    fig, axes = plt.subplots(1, 2, figsize=(11, 4.5))
+    for ax, alg in zip(axes, ("dartboard", "needles")):
+        for kernel in KERNELS:
+            pts = [r for r in rows if r["Algoritmo"] == alg and r["Kernel"] == kernel]
+            ax.loglog([r["Tiempo_s"] for r in pts], [r["RMSE"] for r in pts], "o-", label=kernel)
+        ax.set_title(f"{alg} ({prog}, {workers} workers)")
+        ax.set_xlabel("Tiempo (s)")
+        ax.set_ylabel("RMSE de π")
+        ax.grid(True, which="both", alpha=0.3)
+        ax.legend()
+    fig.tight_layout()
+    png = os.path.join(OUT_DIR, "QMC_Error.png")
+    fig.savefig(png, dpi=120)
+    print(f"Gráfica guardada en: {png}")
+
+if __name__ == "__main__":
+    main()
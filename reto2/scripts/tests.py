@@ -29,7 +29,10 @@ matrix_sizes = [
     1330102642
 ]
 workers = [2, 4, 8, 12]
-iterations = 10
+# Repite hasta que el IC 95% de la mediana quede en ±2% (entre 5 y 50)
+iterations = 50
+min_iterations = 5
+target_ci = 0.02
 
 # Carpetas base
 BIN_DIR = "bin"
@@ -58,12 +61,24 @@ def ensure_dir_exists(path):
     except Exception as e:
         print(f"❌ Error creando {path}: {e}")
 
-def run_and_time(cmd):
-    """Ejecuta un comando y devuelve su tiempo de ejecución."""
+def run_sweep(exe, samples_path):
+    """Ejecuta todo el barrido (tamaños x workers, iteraciones adaptativas) en un solo proceso."""
+    if os.path.exists(samples_path):
+        os.remove(samples_path)
+    sizes = ",".join(str(n) for n in matrix_sizes)
+    threads = ",".join(str(w) for w in workers)
+    cmd = [exe, "--sweep", f"sizes={sizes}", f"threads={threads}",
+           f"reps={iterations}", f"minreps={min_iterations}", f"ci={target_ci}",
+           f"samples={samples_path}"]
     start = time.time()
-    subprocess.run(cmd, shell=True, check=True)
-    end = time.time()
-    return end - start
+    subprocess.run(cmd, check=True)
+    return time.time() - start
+
+def read_samples(samples_path):
+    """Filas (tamaño, workers, repetición, tiempo) escritas por el binario."""
+    with open(samples_path, newline="") as f:
+        for row in csv.DictReader(f):
+            yield int(row["size"]), int(row["workers"]), int(row["rep"]), float(row["time_s"])
 
 def init_csv(filename):
     """Crea un archivo CSV con encabezado."""
@@ -95,16 +110,16 @@ for mode, algos in executables.items():
         ensure_dir_exists(algo_result_dir)
 
         csv_path = init_csv(f"{mode.lower()}_{name.lower()}.csv")
+        samples_path = os.path.join(RESULTS_DIR, f"{mode.lower()}_{name.lower()}_samples.csv")
+
+        # Antes: un proceso por (tamaño, workers, iteración); ahora el binario
+        # recorre todo con --sweep y deja el tiempo de cada repetición
+        try:
+            elapsed = run_sweep(exe, samples_path)
+        except subprocess.CalledProcessError as e:
+            print(f"❌ Error ejecutando {exe}: {e}")
+            continue
 
-        for w in workers:
-            for it in range(1, iterations + 1):
-                for size in matrix_sizes:
-                    cmd = f"{exe} {size} {w}"
-                    try:
-                        elapsed = run_and_time(cmd)
-                        print(f"[{mode}-{name}] Tamaño {size}, Workers {w}, Iter {it} -> {elapsed:.4f} s")
-                        append_csv(csv_path, [mode, name, size, w, it, f"{elapsed:.4f}"])
-                    except subprocess.CalledProcessError as e:
-                        print(f"❌ Error ejecutando {cmd}: {e}")
-                    except Exception as e:
-                        print(f"⚠️ Error inesperado: {e}")
+        for size, w, it, t in read_samples(samples_path):
+            append_csv(csv_path, [mode, name, size, w, it, f"{t:.4f}"])
+        print(f"[{mode}-{name}] Barrido completo en {elapsed:.1f} s")
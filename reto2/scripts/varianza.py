@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+"""Reducción de varianza: estratificado, antitético y control contra escalar.
+
+Para cada kernel corre R réplicas de N muestras con semillas distintas
+(RNG_SEED) y estima la varianza por muestra, N·Var(π̂). Con ella reporta:
+  - factor de reducción de varianza (FRV) = varianza escalar / varianza kernel
+  - eficiencia = FRV · (tiempo escalar / tiempo kernel), lo que de verdad se
+    gana contando que cada muestra puede costar distinto
+  - tiempo hasta la precisión: muestras necesarias para que el IC 95% tenga
+    semiancho relativo `tol`, por el tiempo medido por muestra
+
+Uso: python3 scripts/varianza.py [prog] [workers] [réplicas] [N] [tol]
+     (por defecto hilos 4 16 1000000 1e-4; se corren _dartboard y _needles)
+"""
+import csv, math, os, re, statistics, subprocess, sys
+
+BIN_DIR = "bin"
+OUT_DIR = "results"
+OUT_CSV = os.path.join(OUT_DIR, "Varianza.csv")
+KERNELS = ["escalar", "estratificado", "antitetico", "control"]
+Z = 1.96
+
+PI_RE = re.compile(r"PI.*?:\s*([0-9]+\.[0-9]+)", re.IGNORECASE)
+TIME_RE = re.compile(r"Tiempo (?:real|de usuario):\s*([0-9.eE+-]+)")
+
+def run(exe, n, workers, kernel, seed):
+    args = [exe, str(n)] if "secuencial" in exe else [exe, str(n), str(workers)]
+    env = dict(os.environ, MC_KERNEL=kernel, RNG_SEED=str(seed),
+               BENCH_REPS="1", BENCH_WARMUP="0")
+    env.pop("MC_TOL", None)
+    out = subprocess.check_output(args, text=True, env=env, stderr=subprocess.DEVNULL)
+    pi, t = PI_RE.search(out), TIME_RE.search(out)
+    if not pi or not t:
+        raise RuntimeError(f"salida inesperada de {exe}:\n{out}")
+    return float(pi.group(1)), float(t.group(1))
+
+def main():
+    prog = sys.argv[1] if len(sys.argv) > 1 else "hilos"
+    workers = int(sys.argv[2]) if len(sys.argv) > 2 else 4
+    reps = int(sys.argv[3]) if len(sys.argv) > 3 else 16
+    n = int(float(sys.argv[4])) if len(sys.argv) > 4 else 10**6
+    tol = float(sys.argv[5]) if len(sys.argv) > 5 else 1e-4
+    if reps < 2:
+        print("Error: se necesitan al menos 2 réplicas para estimar la varianza")
+        sys.exit(1)
+
+    rows = []
+    for alg in ("dartboard", "needles"):
+        exe = os.path.join(BIN_DIR, f"{prog}_{alg}")
+        if not os.access(exe, os.X_OK):
+            print(f"No existe {exe}. Primero compila con 'make all'")
+            sys.exit(1)
+        base = None
+        for kernel in KERNELS:
+            runs = [run(exe, n, workers, kernel, 1000 + r) for r in range(reps)]
+            pis = [p for p, _ in runs]
+            var1 = n * statistics.variance(pis)
+            t = statistics.median(t for _, t in runs)
+            needed = (Z * math.sqrt(var1) / (tol * math.pi)) ** 2
+            row = {
+                "Algoritmo": alg, "Kernel": kernel, "N": n,
+                "Workers": 1 if "secuencial" in exe else workers, "Replicas": reps,
+                "Pi_Medio": statistics.fmean(pis), "Varianza_x_Muestra": var1,
+                "Tiempo_s": t, "Tol": tol, "Muestras_Necesarias": needed,
+                "Tiempo_Precision_s": needed * t / n,
+            }
+            if base is None:
+                base = row
+            row["FRV"] = base["Varianza_x_Muestra"] / var1 if var1 > 0 else float("inf")
+            row["Eficiencia"] = base["Tiempo_Precision_s"] / row["Tiempo_Precision_s"] \
+                if row["Tiempo_Precision_s"] > 0 else float("inf")
+            rows.append(row)
+
+    os.makedirs(OUT_DIR, exist_ok=True)
+    with open(OUT_CSV, "w", newline="") as f:
+        w = csv.DictWriter(f, fieldnames=list(rows[0].keys()))
+        w.writeheader()
+        w.writerows(rows)
+
+    print(f"N={n}, {reps} réplicas, precisión objetivo ±{tol:.0e} (IC 95%)")
+    print(f"{'algoritmo':<10} {'kernel':<14} {'var/muestra':>12} {'FRV':>7} "
+          f"{'ns/muestra':>11} {'muestras':>10} {'t. precisión':>13} {'eficiencia':>11}")
+    for r in rows:
+        print(f"{r['Algoritmo']:<10} {r['Kernel']:<14} {r['Varianza_x_Muestra']:>12.4e} {r['FRV']:>7.2f} "
+              f"{1e9 * r['Tiempo_s'] / n:>11.2f} {r['Muestras_Necesarias']:>10.3g} "
+              f"{r['Tiempo_Precision_s']:>12.4f}s {r['Eficiencia']:>10.2f}x")
+    print(f"\nGuardado en: {OUT_CSV}")
+
+if __name__ == "__main__":
+    main()
@@ -6,34 +6,68 @@ N = 100000
 WORKERS = 4
 TOL = 1e-2   # 1% de error permitido
 
-def run_and_check(exe):
+# Modos contador, sobol y halton: misma semilla => mismo π con cualquier
+# implementación y workers
+REPRO_KERNELS = ["contador", "sobol", "halton"]
+REPRO_ENV = {"RNG_SEED": "12345", "BENCH_REPS": "1", "BENCH_WARMUP": "0"}
+REPRO_WORKERS = [1, 3, WORKERS]
+
+def run_and_check(exe, workers=WORKERS, env=None):
     if "secuencial" in exe:
         args = [exe, str(N)]
     else:
-        args = [exe, str(N), str(WORKERS)]
+        args = [exe, str(N), str(workers)]
 
     try:
-        out = subprocess.check_output(args, text=True).strip()
+        out = subprocess.check_output(args, text=True,
+                                      env=dict(os.environ, **env) if env else None).strip()
         # Buscar el número que aparece después de "PI"
         match = re.search(r"PI.*?:\s*([0-9]+\.[0-9]+)", out, re.IGNORECASE)
         if not match:
             return None, f"no se encontró número en la salida:\n{out}"
         pi_est = float(match.group(1))
+        if env is not None:
+            return match.group(1), None
         err = abs(pi_est - math.pi) / math.pi
         return pi_est, err
     except Exception as e:
         return None, str(e)
 
+def check_reproducible(exes):
+    """Con MC_KERNEL=contador, sobol o halton el π impreso tiene que coincidir exactamente."""
+    fails = []
+    for kernel in REPRO_KERNELS:
+        env = dict(REPRO_ENV, MC_KERNEL=kernel)
+        for alg in ("dartboard", "needles"):
+            results = {}
+            for exe in exes:
+                if not exe.endswith("_" + alg):
+                    continue
+                path = os.path.join(BIN_DIR, exe)
+                for w in ([1] if "secuencial" in exe else REPRO_WORKERS):
+                    pi_txt, _ = run_and_check(path, w, env)
+                    results[f"{exe} p={w}"] = pi_txt
+            distinct = set(results.values())
+            if len(distinct) == 1 and None not in distinct:
+                print(f"OK reproducible {alg} ({kernel}): pi={distinct.pop()} en {len(results)} corridas")
+            else:
+                print(f"FAIL reproducible {alg} ({kernel}):")
+                for k, v in results.items():
+                    print(f"    {k}: {v}")
+                fails.append(f"reproducible_{alg}_{kernel}")
+    return fails
+
 def main():
     if not os.path.isdir(BIN_DIR):
         print(f"No existe el directorio {BIN_DIR}. Primero compila con 'make all'")
         sys.exit(1)
 
     fails = []
-    for exe in sorted(os.listdir(BIN_DIR)):
+    exes = [e for e in sorted(os.listdir(BIN_DIR))
+            if os.access(os.path.join(BIN_DIR, e), os.X_OK) and
+            (e.endswith("_dartboard") or e.endswith("_needles"))]
+    for exe in exes:
         path = os.path.join(BIN_DIR, exe)
-        if not os.access(path, os.X_OK):
-            continue
         pi_est, err = run_and_check(path)
         if pi_est is None:
             print(f"ERROR {exe}: al ejecutar ({err})")
@@ -45,6 +79,8 @@ def main():
             print(f"FAIL {exe}: pi≈{pi_est:.6f}, error={err:.2%} > {TOL:.2%}")
             fails.append(exe)
 
+    fails += check_reproducible(exes)
+
     if fails:
         print(f"\nResumen: {len(fails)} fallaron → {', '.join(fails)}")
         sys.exit(1)
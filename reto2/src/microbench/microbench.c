@@ -0,0 +1,254 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "microbench.h"
+#include "mcKernels.h"
+
+#ifndef RESULTS_DIR
+#define RESULTS_DIR "results"
+#endif
+
+/* ==========================================
+ * Microbenchmarks de reto2
+ * ==========================================
+ * El bucle de muestras (kernels/mcKernels.c) en un solo hilo, sin hilos,
+ * procesos ni pool de OpenMP alrededor, frente a los bucles con rand_r y
+ * rand() que usaban antes las implementaciones (referencias locales). Una
+ * "op" es una muestra, así que ns/op es el costo por muestra; no hay
+ * tráfico a memoria (bytes/ciclo queda vacío).
+ */
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static const long defaultSizes[] = { 100000, 1000000 };
+
+typedef struct {
+    long n;
+    unsigned int seed;
+    Rng rng;
+    RngVec lanes;
+    Sobol2 sobol;
+    Halton2 halton;
+    long hits;              // se guarda para que el compilador no descarte el kernel
+} SampleCtx;
+
+/* ==========================================
+ * Referencias: generadores anteriores
+ * ========================================== */
+/* hilos y procesos: rand_r con una semilla por worker */
+static long dartboardRandR(long n, unsigned int* seed) {
+    long hits = 0;
+    for (long i = 0; i < n; i++) {
+        double x = (double)rand_r(seed) / RAND_MAX;
+        double y = (double)rand_r(seed) / RAND_MAX;
+        if (x*x + y*y <= 1.0) hits++;
+    }
+    return hits;
+}
+
+/* openmp: rand_r resembrado en cada muestra con base ^ i */
+static long dartboardRandRPerSample(long n, unsigned int base) {
+    long hits = 0;
+    for (long i = 0; i < n; i++) {
+        unsigned int seed = (unsigned int)(base ^ i);
+        double x = (double)rand_r(&seed) / RAND_MAX;
+        double y = (double)rand_r(&seed) / RAND_MAX;
+        if (x*x + y*y <= 1.0) hits++;
+    }
+    return hits;
+}
+
+/* secuencial: rand() de libc, estado global con lock */
+static long needlesRand(long n, double len, double dist) {
+    long hits = 0;
+    for (long i = 0; i < n; i++) {
+        double y = ((double)rand() / RAND_MAX) * (dist / 2.0);
+        double theta = ((double)rand() / RAND_MAX) * (M_PI / 2.0);
+        if (y <= (len / 2.0) * sin(theta)) hits++;
+    }
+    return hits;
+}
+
+static long needlesRandRPerSample(long n, unsigned int base, double len, double dist) {
+    long hits = 0;
+    for (long i = 0; i < n; i++) {
+        unsigned int seed = (unsigned int)(base ^ i);
+        double y = ((double)rand_r(&seed) / RAND_MAX) * (dist / 2.0);
+        double theta = ((double)rand_r(&seed) / RAND_MAX) * (M_PI / 2.0);
+        if (y <= (len / 2.0) * sin(theta)) hits++;
+    }
+    return hits;
+}
+
+/* ==========================================
+ * Variantes
+ * ========================================== */
+static void runDartboardRandR(void* ctx) {
+    SampleCtx* s = (SampleCtx*)ctx;
+    s->hits += dartboardRandR(s->n, &s->seed);
+}
+
+static void runDartboardPerSample(void* ctx) {
+    SampleCtx* s = (SampleCtx*)ctx;
+    s->hits += dartboardRandRPerSample(s->n, s->seed);
+}
+
+static void runDartboardXoshiro(void* ctx) {
+    SampleCtx* s = (SampleCtx*)ctx;
+    s->hits += dartboardSamples(s->n, &s->rng);
+}
+
+static void runDartboardSimd(void* ctx) {
+    SampleCtx* s = (SampleCtx*)ctx;
+    s->hits += dartboardSamplesSimd(s->n, &s->lanes);
+}
+
+static void runNeedlesSimd(void* ctx) {
+    SampleCtx* s = (SampleCtx*)ctx;
+    s->hits += needlesSamplesSimd(s->n, &s->lanes, MC_NEEDLE_LEN, MC_NEEDLE_DIST);
+}
+
+static void runDartboardCounter(void* ctx) {
+    SampleCtx* s = (SampleCtx*)ctx;
+    s->hits += dartboardCounter(s->seed, 0, s->n);
+}
+
+static void runNeedlesCounter(void* ctx) {
+    SampleCtx* s = (SampleCtx*)ctx;
+    s->hits += needlesCounter(s->seed, 0, s->n, MC_NEEDLE_LEN, MC_NEEDLE_DIST);
+}
+
+static const McProblem dartboardProblem = { 0, 0.0, 0.0 };
+static const McProblem needlesProblem = { 1, MC_NEEDLE_LEN, MC_NEEDLE_DIST };
+
+static void runDartboardSobol(void* ctx) {
+    SampleCtx* s = (SampleCtx*)ctx;
+    s->hits += sobolSamples(&s->sobol, &dartboardProblem, 0, s->n);
+}
+
+static void runDartboardHalton(void* ctx) {
+    SampleCtx* s = (SampleCtx*)ctx;
+    s->hits += haltonSamples(&s->halton, &dartboardProblem, 0, s->n);
+}
+
+static void runNeedlesSobol(void* ctx) {
+    SampleCtx* s = (SampleCtx*)ctx;
+    s->hits += sobolSamples(&s->sobol, &needlesProblem, 0, s->n);
+}
+
+static void runNeedlesHalton(void* ctx) {
+    SampleCtx* s = (SampleCtx*)ctx;
+    s->hits += haltonSamples(&s->halton, &needlesProblem, 0, s->n);
+}
+
+static void runDartboardStratified(void* ctx) {
+    SampleCtx* s = (SampleCtx*)ctx;
+    s->hits += stratifiedSamples(s->seed, &s->rng, &dartboardProblem, 0, s->n);
+}
+
+static void runDartboardAntithetic(void* ctx) {
+    SampleCtx* s = (SampleCtx*)ctx;
+    s->hits += antitheticSamples(&s->rng, &dartboardProblem, s->n);
+}
+
+static void runDartboardControl(void* ctx) {
+    SampleCtx* s = (SampleCtx*)ctx;
+    s->hits += controlSamples(&s->rng, &dartboardProblem, s->n);
+}
+
+static void runNeedlesStratified(void* ctx) {
+    SampleCtx* s = (SampleCtx*)ctx;
+    s->hits += stratifiedSamples(s->seed, &s->rng, &needlesProblem, 0, s->n);
+}
+
+static void runNeedlesAntithetic(void* ctx) {
+    SampleCtx* s = (SampleCtx*)ctx;
+    s->hits += antitheticSamples(&s->rng, &needlesProblem, s->n);
+}
+
+static void runNeedlesControl(void* ctx) {
+    SampleCtx* s = (SampleCtx*)ctx;
+    s->hits += controlSamples(&s->rng, &needlesProblem, s->n);
+}
+
+static void runNeedlesRand(void* ctx) {
+    SampleCtx* s = (SampleCtx*)ctx;
+    s->hits += needlesRand(s->n, MC_NEEDLE_LEN, MC_NEEDLE_DIST);
+}
+
+static void runNeedlesPerSample(void* ctx) {
+    SampleCtx* s = (SampleCtx*)ctx;
+    s->hits += needlesRandRPerSample(s->n, s->seed, MC_NEEDLE_LEN, MC_NEEDLE_DIST);
+}
+
+static void runNeedlesXoshiro(void* ctx) {
+    SampleCtx* s = (SampleCtx*)ctx;
+    s->hits += needlesSamples(s->n, &s->rng, MC_NEEDLE_LEN, MC_NEEDLE_DIST);
+}
+
+typedef struct {
+    const char* group;
+    const char* variant;
+    MicroKernelFn fn;
+} Variant;
+
+/* La primera variante de cada grupo es la referencia de la tabla */
+static const Variant variants[] = {
+    { "dartboard", "rand_r",           runDartboardRandR },     // antes: hilos, procesos
+    { "dartboard", "rand_r_x_muestra", runDartboardPerSample }, // antes: openmp
+    { "dartboard", "xoshiro256pp",     runDartboardXoshiro },   // MC_KERNEL=escalar
+    { "dartboard", "xoshiro_simd",     runDartboardSimd },      // MC_KERNEL=simd
+    { "dartboard", "contador",         runDartboardCounter },   // MC_KERNEL=contador
+    { "dartboard", "sobol",            runDartboardSobol },     // MC_KERNEL=sobol
+    { "dartboard", "halton",           runDartboardHalton },    // MC_KERNEL=halton
+    { "dartboard", "estratificado",    runDartboardStratified },// MC_KERNEL=estratificado
+    { "dartboard", "antitetico",       runDartboardAntithetic },// MC_KERNEL=antitetico
+    { "dartboard", "control",          runDartboardControl },   // MC_KERNEL=control
+    { "needles",   "rand",             runNeedlesRand },        // antes: secuencial
+    { "needles",   "rand_r_x_muestra", runNeedlesPerSample },   // antes: openmp
+    { "needles",   "xoshiro256pp",     runNeedlesXoshiro },     // MC_KERNEL=escalar
+    { "needles",   "sin_trig_simd",    runNeedlesSimd },        // MC_KERNEL=simd
+    { "needles",   "contador",         runNeedlesCounter },     // MC_KERNEL=contador
+    { "needles",   "sobol",            runNeedlesSobol },       // MC_KERNEL=sobol
+    { "needles",   "halton",           runNeedlesHalton },      // MC_KERNEL=halton
+    { "needles",   "estratificado",    runNeedlesStratified },  // MC_KERNEL=estratificado
+    { "needles",   "antitetico",       runNeedlesAntithetic },  // MC_KERNEL=antitetico
+    { "needles",   "control",          runNeedlesControl },     // MC_KERNEL=control
+};
+
+int main(int argc, char* argv[]) {
+    MicroSuite suite;
+    BenchSweep grid;
+    microInit(&suite, "reto2", &grid, argc, argv);
+    if (grid.nworkers > 0) {
+        fprintf(stderr, "Error: los kernels de reto2 se miden en un solo hilo (sin threads=)\n");
+        return EXIT_FAILURE;
+    }
+    if (grid.nsizes == 0) {
+        grid.nsizes = sizeof(defaultSizes) / sizeof(defaultSizes[0]);
+        for (int i = 0; i < grid.nsizes; i++) grid.sizes[i] = defaultSizes[i];
+    }
+    srand(42);
+
+    long sink = 0;
+    for (int i = 0; i < grid.nsizes; i++) {
+        for (size_t v = 0; v < sizeof(variants) / sizeof(variants[0]); v++) {
+            SampleCtx ctx = { .n = grid.sizes[i], .seed = 12345u };
+            rngSeed(&ctx.rng, 12345u);
+            rngVecStream(&ctx.lanes, 12345u, 0);
+            sobolInit(&ctx.sobol, 12345u, 1);
+            haltonInit(&ctx.halton, 12345u, 1);
+            MicroCase c = { variants[v].group, variants[v].variant, grid.sizes[i], 1,
+                            (double)grid.sizes[i], 0.0 };
+            microRun(&suite, &c, variants[v].fn, &ctx);
+            sink += ctx.hits;
+        }
+    }
+    if (sink < 0) printf("%ld\n", sink);
+
+    microFinish(&suite, RESULTS_DIR);
+    return 0;
+}
@@ -0,0 +1,16 @@
+#include "mcEngine.h"
+
+#ifndef RESULTS_DIR
+#define RESULTS_DIR "results"
+#endif
+
+/* Cada binario histórico (hilos_dartboard, ...) es este mismo archivo con
+ * -DMC_PROGRAM fijando backend y problema; sin él, bin/montecarlo los
+ * recibe por línea de comandos */
+#ifndef MC_PROGRAM
+#define MC_PROGRAM NULL
+#endif
+
+int main(int argc, char* argv[]) {
+    return mcMain("reto2", RESULTS_DIR, MC_PROGRAM, argc, argv);
+}
@@ -0,0 +1,87 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "procPool.h"
+
+/* ==========================================
+ * Prueba de estrés del pool de procesos
+ * ==========================================
+ * Alterna trabajos con 1 y con N hijos activos (el patrón de un barrido
+ * threads=1,N) muchas veces seguidas. Cada generación tiene su propio
+ * contador en memoria compartida: si un hijo corriera una generación que
+ * no le toca, o la misma dos veces, algún contador no cuadra; si pending
+ * se desbordara, el padre quedaría esperando y salta la alarma.
+ *
+ *   stress_pool [workers] [iteraciones]
+ */
+
+#define STRESS_TIMEOUT_S 60
+
+typedef struct {
+    long generation;        // escrito por el padre antes de cada procPoolRun
+    long* runs;             // runs[g]: veces que algún hijo corrió la generación g
+    long* perWorker;        // perWorker[id]: generaciones corridas por el hijo id
+} StressArg;
+
+static void stressTask(void* arg, int worker) {
+    StressArg* s = arg;
+    __atomic_add_fetch(&s->runs[s->generation], 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&s->perWorker[worker], 1, __ATOMIC_RELAXED);
+}
+
+static void* sharedAlloc(size_t bytes) {
+    void* p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+        perror("mmap");
+        exit(EXIT_FAILURE);
+    }
+    memset(p, 0, bytes);
+    return p;
+}
+
+int main(int argc, char* argv[]) {
+    const int workers = argc > 1 ? atoi(argv[1]) : 8;
+    const long iterations = argc > 2 ? atol(argv[2]) : 20000;
+    if (workers < 2 || iterations < 1) {
+        fprintf(stderr, "Uso: %s [workers >= 2] [iteraciones >= 1]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    StressArg* s = sharedAlloc(sizeof(StressArg));
+    s->runs = sharedAlloc((size_t)iterations * sizeof(long));
+    s->perWorker = sharedAlloc((size_t)workers * sizeof(long));
+
+    alarm(STRESS_TIMEOUT_S);        // un pool colgado termina el proceso con SIGALRM
+    ProcPool* pool = procPoolCreate(workers);
+    for (long g = 0; g < iterations; g++) {
+        s->generation = g;
+        procPoolRun(pool, g % 2 == 0 ? 1 : workers, stressTask, s);
+    }
+    procPoolFree(pool);
+    alarm(0);
+
+    int errors = 0;
+    for (long g = 0; g < iterations; g++) {
+        const long expected = g % 2 == 0 ? 1 : workers;
+        if (s->runs[g] != expected && errors++ < 10)
+            fprintf(stderr, "Error: generación %ld corrida %ld veces (esperadas %ld)\n",
+                    g, s->runs[g], expected);
+    }
+    const long odd = iterations / 2;      // generaciones con todos los hijos
+    for (int w = 0; w < workers; w++) {
+        const long expected = w == 0 ? iterations : odd;
+        if (s->perWorker[w] != expected && errors++ < 10)
+            fprintf(stderr, "Error: el hijo %d corrió %ld generaciones (esperadas %ld)\n",
+                    w, s->perWorker[w], expected);
+    }
+
+    if (errors > 0) {
+        fprintf(stderr, "stress_pool: %d errores\n", errors);
+        return EXIT_FAILURE;
+    }
+    printf("stress_pool: %ld generaciones alternando 1/%d hijos, OK\n", iterations, workers);
+    return EXIT_SUCCESS;
+}
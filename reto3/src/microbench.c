@@ -0,0 +1,89 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "microbench.h"
+#include "trafficStep.h"
+
+/* ==========================================
+ * Microbenchmarks de reto3
+ * ==========================================
+ * Un paso del autómata sobre N celdas, sin MPI ni halos de por medio:
+ *   modulo    trafficStepRing (traffic_serial): % N y escritura dispersa
+ *   halo      trafficStepHalo (traffic_mpi) sobre un tramo con fantasmas
+ *   gather    referencia local: cada celda se calcula solo a partir de sus
+ *             vecinas (next[i] = auto que se queda o que llega desde i-1),
+ *             sin memset ni escrituras dispersas, así que vectoriza
+ * Una "op" es una celda. Los bytes son el modelo del roofline de los
+ * programas (16 por celda) salvo gather, que solo lee road y escribe next.
+ */
+#define OPS_PER_CELL 8.0
+#define BYTES_PER_CELL 16.0
+#define GATHER_BYTES_PER_CELL 8.0
+
+static const long defaultSizes[] = { 10000, 100000, 1000000 };
+
+typedef struct {
+    int* road;              // N + 2 celdas: road[1..N] es la calle, 0 y N + 1 fantasmas
+    int* next;
+    int N;
+} StepCtx;
+
+static void runRing(void* ctx) {
+    StepCtx* s = (StepCtx*)ctx;
+    trafficStepRing(s->road + 1, s->next + 1, s->N);
+}
+
+static void runHalo(void* ctx) {
+    StepCtx* s = (StepCtx*)ctx;
+    trafficStepHalo(s->road, s->next, s->N);
+}
+
+/* Regla 184 como gather: la celda i queda ocupada si su auto no puede
+ * avanzar o si entra el de i-1 */
+static void runGather(void* ctx) {
+    StepCtx* s = (StepCtx*)ctx;
+    const int* restrict road = s->road;
+    int* restrict next = s->next;
+    for (int i = 1; i <= s->N; i++)
+        next[i] = (road[i] & road[i + 1]) | (road[i - 1] & !road[i]);
+}
+
+int main(int argc, char* argv[]) {
+    MicroSuite suite;
+    BenchSweep grid;
+    microInit(&suite, "reto3", &grid, argc, argv);
+    if (grid.nworkers > 0) {
+        fprintf(stderr, "Error: el paso de reto3 se mide en un solo proceso (sin threads=)\n");
+        return EXIT_FAILURE;
+    }
+    if (grid.nsizes == 0) {
+        grid.nsizes = sizeof(defaultSizes) / sizeof(defaultSizes[0]);
+        for (int i = 0; i < grid.nsizes; i++) grid.sizes[i] = defaultSizes[i];
+    }
+    srand(42);
+
+    for (int i = 0; i < grid.nsizes; i++) {
+        int N = (int)grid.sizes[i];
+        StepCtx s = { calloc(N + 2, sizeof(int)), calloc(N + 2, sizeof(int)), N };
+        if (s.road == NULL || s.next == NULL) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para N=%d\n", N);
+            return EXIT_FAILURE;
+        }
+        /* Densidad 0.3 como los scripts; siempre se avanza desde el mismo estado */
+        for (int c = 1; c <= N; c++) s.road[c] = (rand() / (double)RAND_MAX) < 0.3;
+
+        MicroCase c = { "paso", "modulo", N, 1, OPS_PER_CELL * N, BYTES_PER_CELL * N };
+        microRun(&suite, &c, runRing, &s);
+        c.variant = "halo";
+        microRun(&suite, &c, runHalo, &s);
+        c.variant = "gather";
+        c.bytes = GATHER_BYTES_PER_CELL * N;
+        microRun(&suite, &c, runGather, &s);
+
+        free(s.road);
+        free(s.next);
+    }
+
+    microFinish(&suite, "results");
+    return 0;
+}
@@ -0,0 +1,29 @@
+#include <string.h>
+
+#include "trafficStep.h"
+
+void trafficStepRing(const int* road, int* next, int N) {
+    memset(next, 0, N * sizeof(int));
+
+    for (int i = 0; i < N; i++) {
+        int right = (i + 1) % N;
+        int move = (road[i] == 1 && road[right] == 0);
+
+        next[i] |= road[i] & !move;
+        next[right] |= move;
+    }
+}
+
+void trafficStepHalo(const int* road, int* next, int local_N) {
+    memset(next, 0, (local_N + 2) * sizeof(int));
+
+    for (int i = 1; i <= local_N; i++) {
+        int right = i + 1;
+        if (right > local_N) right = local_N + 1;
+
+        int move = (road[i] == 1 && road[right] == 0);
+
+        next[i] |= road[i] & !move;
+        next[right] |= move;
+    }
+}
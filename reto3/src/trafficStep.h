@@ -0,0 +1,19 @@
+#ifndef TRAFFIC_STEP_H
+#define TRAFFIC_STEP_H
+
+/* ==========================================
+ * Un paso del autómata de tráfico (regla 184)
+ * ==========================================
+ * Cada auto avanza una celda si la de adelante está libre. Los programas y
+ * el microbenchmark llaman a estas mismas funciones.
+ */
+
+/* Calle circular de N celdas (traffic_serial): el vecino de la última es
+ * la primera, con % N en cada celda */
+void trafficStepRing(const int* road, int* next, int N);
+
+/* Tramo local con celdas fantasma en 0 y local_N + 1 (traffic_mpi); los
+ * halos ya tienen que estar intercambiados */
+void trafficStepHalo(const int* road, int* next, int local_N);
+
+#endif
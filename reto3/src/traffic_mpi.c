@@ -2,10 +2,28 @@
 #include <stdlib.h>
 #include <string.h>
 #include <mpi.h>
-#include <sys/resource.h>
 
-double timeval_to_seconds(struct timeval tv) {
-    return tv.tv_sec + tv.tv_usec / 1e6;
+#include "roofline.h"
+#include "hpcbench.h"
+#include "scaling.h"
+#include "memTrack.h"
+#include "trafficStep.h"
+
+#define ROOFLINE_DIR "results/roofline"
+
+/* Modelo del roofline por celda y paso: ~8 operaciones enteras (vecino,
+ * comparaciones, and/not/or) y 16 bytes (leer road, limpiar next y
+ * leer+escribir next). Con N pequeño las calles caben en caché y el
+ * tráfico real a memoria es menor. */
+#define OPS_PER_CELL 8.0
+#define BYTES_PER_CELL 16.0
+
+/* En modo adaptativo (BENCH_TARGET_CI) cada rango vería un IC distinto y
+ * cortaría en otra repetición: manda la decisión de rank 0 */
+static int runNextAllRanks(BenchRun* run) {
+    int more = benchRunNext(run);
+    MPI_Bcast(&more, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    return more;
 }
 
 int main(int argc, char **argv) {
@@ -34,9 +52,15 @@ int main(int argc, char **argv) {
     }
     MPI_Barrier(MPI_COMM_WORLD);
 
+    /* Todos los rangos deben hacer las mismas corridas: manda la de rank 0 */
+    BenchConfig benchConfig;
+    if (rank == 0) benchConfigInit(&benchConfig);
+    MPI_Bcast(&benchConfig, sizeof(benchConfig), MPI_BYTE, 0, MPI_COMM_WORLD);
+
     int local_N = N / size;
     if (rank == size - 1) local_N += N % size;
 
+    memTrackPhase("generacion");
     int* road = calloc(local_N + 2, sizeof(int));
     int* next = calloc(local_N + 2, sizeof(int));
 
@@ -47,71 +71,81 @@ int main(int argc, char **argv) {
         road[i] = (r < density) ? 1 : 0;
     }
 
+    /* Estado inicial intacto: cada repetición parte de la misma calle */
+    int* road0 = malloc((local_N + 2) * sizeof(int));
+    memcpy(road0, road, (local_N + 2) * sizeof(int));
+
     long long local_cars = 0;
     for (int i = 1; i <= local_N; i++) local_cars += road[i];
 
     long long total_cars = 0;
     MPI_Reduce(&local_cars, &total_cars, 1, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
 
-    struct rusage start_u, end_u;
-    if (rank == 0) getrusage(RUSAGE_SELF, &start_u);
+    double comm_sum = 0;
 
-    MPI_Barrier(MPI_COMM_WORLD);
-    double t0 = MPI_Wtime();
+    /* Un solo worker por rango: sus pasos (halos incluidos) y la espera en
+     * la barrera final */
+    WorkerTimes times;
+    workerTimesInit(&times, 1, 0);
 
-    double comm_time = 0;
+    memTrackPhase("calculo");
 
-    for (int t = 0; t < steps; t++) {
+    BenchRun run;
+    benchRunInit(&run, &benchConfig);
+    while (runNextAllRanks(&run)) {
+        memcpy(road, road0, (local_N + 2) * sizeof(int));
+        double comm_time = 0;
 
-        double comm_s = MPI_Wtime();
+        MPI_Barrier(MPI_COMM_WORLD);
+        benchStart(&run);
+        times.start[0] = benchNow();
 
-        int left_rank = (rank == 0) ? size - 1 : rank - 1;
-        int right_rank = (rank + 1) % size;
+        for (int t = 0; t < steps; t++) {
 
-        MPI_Sendrecv(&road[1], 1, MPI_INT, left_rank, 0,
-                     &road[local_N + 1], 1, MPI_INT, right_rank, 0,
-                     MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+            double comm_s = MPI_Wtime();
 
-        MPI_Sendrecv(&road[local_N], 1, MPI_INT, right_rank, 1,
-                     &road[0], 1, MPI_INT, left_rank, 1,
-                     MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+            int left_rank = (rank == 0) ? size - 1 : rank - 1;
+            int right_rank = (rank + 1) % size;
 
-        comm_time += MPI_Wtime() - comm_s;
+            MPI_Sendrecv(&road[1], 1, MPI_INT, left_rank, 0,
+                         &road[local_N + 1], 1, MPI_INT, right_rank, 0,
+                         MPI_COMM_WORLD, MPI_STATUS_IGNORE);
 
-        memset(next, 0, (local_N + 2) * sizeof(int));
+            MPI_Sendrecv(&road[local_N], 1, MPI_INT, right_rank, 1,
+                         &road[0], 1, MPI_INT, left_rank, 1,
+                         MPI_COMM_WORLD, MPI_STATUS_IGNORE);
 
-        for (int i = 1; i <= local_N; i++) {
-            int right = i + 1;
-            if (right > local_N) right = local_N + 1;
+            comm_time += MPI_Wtime() - comm_s;
 
-            int move = (road[i] == 1 && road[right] == 0);
+            trafficStepHalo(road, next, local_N);
 
-            next[i] |= road[i] & !move;
-            next[right] |= move;
+            int* tmp = road;
+            road = next;
+            next = tmp;
         }
+        times.end[0] = benchNow();
 
-        int* tmp = road;
-        road = next;
-        next = tmp;
+        MPI_Barrier(MPI_COMM_WORLD);
+        benchStop(&run);
+        workerTimesJoin(&times, &run);
+        if (!benchIsWarmup(&run)) comm_sum += comm_time;
     }
+    benchRunFinish(&run);
 
-    MPI_Barrier(MPI_COMM_WORLD);
-    double t1 = MPI_Wtime();
-
-    if (rank == 0) {
-        getrusage(RUSAGE_SELF, &end_u);
+    /* Rank 0 junta el tiempo ocupado y la espera en la barrera de cada rango */
+    WorkerTimes ranks;
+    if (rank == 0) workerTimesInit(&ranks, size, 0);
+    MPI_Gather(times.busy, 1, MPI_DOUBLE, rank == 0 ? ranks.busy : NULL, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    MPI_Gather(times.idle, 1, MPI_DOUBLE, rank == 0 ? ranks.idle : NULL, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    workerTimesFree(&times);
 
-        double mpi_time = t1 - t0;
+    double mpi_time = run.summary.median;
+    double comm_time = comm_sum / run.summary.n;
 
-        double user_cpu =
-            timeval_to_seconds(end_u.ru_utime) -
-            timeval_to_seconds(start_u.ru_utime);
-
-        double sys_cpu =
-            timeval_to_seconds(end_u.ru_stime) -
-            timeval_to_seconds(start_u.ru_stime);
-
-        size_t mem_kb = end_u.ru_maxrss;
+    if (rank == 0) {
+        double user_cpu = run.user_time;
+        double sys_cpu = run.system_time;
+        size_t mem_kb = run.max_rss_kb;
 
         FILE* f = fopen(out_csv, "w");
         fprintf(f,
@@ -120,11 +154,32 @@ int main(int argc, char **argv) {
             N, mpi_time, user_cpu, sys_cpu, mem_kb, comm_time
         );
         fclose(f);
+
+        benchPrintSummary(&run);
+        BenchRecord record = {"reto3", "traffic_mpi", "mpi", N, size, OPS_PER_CELL * N * steps};
+        benchWriteUnified("results", &record, &run);
+
+        ranks.reps = run.summary.n;
+        ScalingStudy scaling;
+        scalingInit(&scaling);
+        scalingAdd(&scaling, &record, &run, &ranks);
+        scalingFinish(&scaling, "results");
+        workerTimesFree(&ranks);
+        /* Solo la memoria de rank 0 (incluye los buffers internos de MPI) */
+        memTrackReport("results", &record);
     }
+    benchRunFree(&run);
 
+    free(road0);
     free(road);
     free(next);
 
     MPI_Finalize();
+
+    /* Fuera de MPI para que una calibración (si no está en caché) no
+     * compita con los demás rangos */
+    if (rank == 0)
+        rooflineReport(ROOFLINE_DIR, "traffic_mpi", N, size, ROOFLINE_INT,
+                       OPS_PER_CELL * N * steps, BYTES_PER_CELL * N * steps, &run.summary, NULL);
     return 0;
 }
@@ -2,11 +2,20 @@
 #include <stdlib.h>
 #include <time.h>
 #include <string.h>
-#include <sys/resource.h>
 
-double timeval_to_seconds(struct timeval tv) {
-    return tv.tv_sec + tv.tv_usec / 1e6;
-}
+#include "roofline.h"
+#include "hpcbench.h"
+#include "memTrack.h"
+#include "trafficStep.h"
+
+#define ROOFLINE_DIR "results/roofline"
+
+/* Modelo del roofline por celda y paso: ~8 operaciones enteras (vecino,
+ * comparaciones, and/not/or) y 16 bytes (leer road, limpiar next y
+ * leer+escribir next). Con N pequeño las calles caben en caché y el
+ * tráfico real a memoria es menor. */
+#define OPS_PER_CELL 8.0
+#define BYTES_PER_CELL 16.0
 
 int* create_road(int N, double density) {
     int* road = malloc(N * sizeof(int));
@@ -32,52 +41,43 @@ int main(int argc, char** argv) {
 
     system("mkdir -p results");
 
-    int* road = create_road(N, density);
+    BenchConfig benchConfig;
+    benchConfigInit(&benchConfig);
+
+    /* Estado inicial intacto: cada repetición parte de la misma calle */
+    memTrackPhase("generacion");
+    int* road0 = create_road(N, density);
+    int* road = malloc(N * sizeof(int));
     int* next = calloc(N, sizeof(int));
 
     long long total_cars = 0;
     for (int i = 0; i < N; i++)
-        total_cars += road[i];
-
-    struct rusage start_u, end_u;
-    getrusage(RUSAGE_SELF, &start_u);
-
-    struct timespec t0, t1;
-    clock_gettime(CLOCK_MONOTONIC, &t0);
+        total_cars += road0[i];
 
-    for (int t = 0; t < steps; t++) {
+    memTrackPhase("calculo");
+    BenchRun run;
+    benchRunInit(&run, &benchConfig);
+    while (benchRunNext(&run)) {
+        memcpy(road, road0, N * sizeof(int));
+        benchStart(&run);
 
-        memset(next, 0, N * sizeof(int));
+        for (int t = 0; t < steps; t++) {
 
-        for (int i = 0; i < N; i++) {
-            int right = (i + 1) % N;
-            int move = (road[i] == 1 && road[right] == 0);
+            trafficStepRing(road, next, N);
 
-            next[i] |= road[i] & !move;
-            next[right] |= move;
+            int* tmp = road;
+            road = next;
+            next = tmp;
         }
 
-        int* tmp = road;
-        road = next;
-        next = tmp;
+        benchStop(&run);
     }
+    benchRunFinish(&run);
 
-    clock_gettime(CLOCK_MONOTONIC, &t1);
-    getrusage(RUSAGE_SELF, &end_u);
-
-    double real_time =
-        (t1.tv_sec - t0.tv_sec) +
-        (t1.tv_nsec - t0.tv_nsec) / 1e9;
-
-    double user_cpu =
-        timeval_to_seconds(end_u.ru_utime) -
-        timeval_to_seconds(start_u.ru_utime);
-
-    double sys_cpu =
-        timeval_to_seconds(end_u.ru_stime) -
-        timeval_to_seconds(start_u.ru_stime);
-
-    size_t mem_kb = end_u.ru_maxrss;
+    double real_time = run.summary.median;
+    double user_cpu = run.user_time;
+    double sys_cpu = run.system_time;
+    size_t mem_kb = run.max_rss_kb;
 
     FILE* f = fopen(out_csv, "w");
     fprintf(f,
@@ -87,6 +87,16 @@ int main(int argc, char** argv) {
     );
     fclose(f);
 
+    benchPrintSummary(&run);
+    BenchRecord record = {"reto3", "traffic_serial", "serial", N, 1, OPS_PER_CELL * N * steps};
+    benchWriteUnified("results", &record, &run);
+    memTrackReport("results", &record);
+    benchRunFree(&run);
+
+    rooflineReport(ROOFLINE_DIR, "traffic_serial", N, 1, ROOFLINE_INT,
+                   OPS_PER_CELL * N * steps, BYTES_PER_CELL * N * steps, &run.summary, NULL);
+
+    free(road0);
     free(road);
     free(next);
 